@@ -1,10 +1,13 @@
 import random
 import os
+import argparse
 
 # --- 配置区 ---
 OUTPUT_DIR = "maps"
 MAP_SIZE = 100
 MAP_FILE = os.path.join(OUTPUT_DIR, "map1.txt")
+SHIP_COUNT = 5          # 写入头部的船数
+WRITE_HEADER = False    # 是否在首行写入头部 "行数 列数 机器人数 船数"
 
 # 地图元素概率
 LAND_PROB = 0.65        # 空地概率
@@ -18,7 +21,7 @@ NUM_BERTHS = 5          # 泊位数
 
 def generate_map():
     """生成港口地图"""
-    os.makedirs(OUTPUT_DIR, exist_ok=True)
+    os.makedirs(os.path.dirname(MAP_FILE) or ".", exist_ok=True)
 
     # 初始化地图为空地
     grid = [['.' for _ in range(MAP_SIZE)] for _ in range(MAP_SIZE)]
@@ -35,7 +38,7 @@ def generate_map():
     # 放置机器人起点（确保在空地上）
     placed_starts = 0
     attempts = 0
-    while placed_starts < NUM_START_POINTS and attempts < 1000:
+    while placed_starts < NUM_START_POINTS and attempts < 1000 * NUM_START_POINTS:
         r = random.randint(0, MAP_SIZE - 1)
         c = random.randint(0, MAP_SIZE - 1)
         if grid[r][c] == '.':
@@ -46,7 +49,7 @@ def generate_map():
     # 放置泊位（确保在空地上，且靠近边缘或海洋）
     placed_berths = 0
     attempts = 0
-    while placed_berths < NUM_BERTHS and attempts < 1000:
+    while placed_berths < NUM_BERTHS and attempts < 1000 * NUM_BERTHS:
         r = random.randint(0, MAP_SIZE - 1)
         c = random.randint(0, MAP_SIZE - 1)
         
@@ -70,6 +73,8 @@ def generate_map():
 
     # 保存地图
     with open(MAP_FILE, 'w') as f:
+        if WRITE_HEADER:
+            f.write(f"{MAP_SIZE} {MAP_SIZE} {NUM_START_POINTS} {SHIP_COUNT}\n")
         for row in grid:
             f.write(''.join(row) + '\n')
 
@@ -85,12 +90,26 @@ def generate_map():
     obstacle_count = sum(row.count('#') for row in grid)
     
     print(f"\n地图统计:")
-    print(f"  空地 (.): {land_count} ({land_count/100:.1f}%)")
-    print(f"  海洋 (*): {sea_count} ({sea_count/100:.1f}%)")
-    print(f"  障碍 (#): {obstacle_count} ({obstacle_count/100:.1f}%)")
+    cells = MAP_SIZE * MAP_SIZE
+    print(f"  空地 (.): {land_count} ({land_count * 100 / cells:.1f}%)")
+    print(f"  海洋 (*): {sea_count} ({sea_count * 100 / cells:.1f}%)")
+    print(f"  障碍 (#): {obstacle_count} ({obstacle_count * 100 / cells:.1f}%)")
     print(f"  起点 (A): {placed_starts}")
     print(f"  泊位 (B): {placed_berths}")
 
 
 if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="生成港口地图")
+    parser.add_argument("--size", type=int, default=MAP_SIZE, help="地图边长")
+    parser.add_argument("--robots", type=int, default=NUM_START_POINTS, help="机器人起点数")
+    parser.add_argument("--berths", type=int, default=NUM_BERTHS, help="泊位数")
+    parser.add_argument("--ships", type=int, default=SHIP_COUNT, help="船数（仅写入头部）")
+    parser.add_argument("--out", default=MAP_FILE, help="输出文件")
+    parser.add_argument("--seed", type=int, default=None, help="随机种子")
+    parser.add_argument("--header", action="store_true", help="在首行写入规模头部")
+    opts = parser.parse_args()
+    MAP_SIZE, NUM_START_POINTS, NUM_BERTHS, SHIP_COUNT = opts.size, opts.robots, opts.berths, opts.ships
+    MAP_FILE, WRITE_HEADER = opts.out, opts.header
+    if opts.seed is not None:
+        random.seed(opts.seed)
     generate_map()
@@ -4,28 +4,81 @@ import random
 import os
 import time
 import platform
+import struct
+import select
 
 # --- 配置区 ---
 MAP_FILE = "maps/map1.txt"
 MAX_FRAMES = 1000
 ROBOT_COUNT = 10
 SHIP_COUNT = 5
-MAP_SIZE = 100
+MAP_ROWS = 100
+MAP_COLS = 100
+
+# 可选参数：--map 地图文件  --robots 机器人数  --ships 船数  --binary 使用二进制协议
+#           --shm 经共享内存而不是管道交换数据（仅 Linux）  --delta 发送增量帧
+#           --budget 程序的每帧时间预算（毫秒，0表示不限），只转交给程序
+# 其余为位置参数：可执行文件 随机种子
+args = []
+options = {}
+BINARY = False
+SHM = False
+DELTA = False
+i = 1
+while i < len(sys.argv):
+    if sys.argv[i] == "--binary":
+        BINARY = True
+        i += 1
+    elif sys.argv[i] == "--shm":
+        SHM = True
+        i += 1
+    elif sys.argv[i] == "--delta":
+        DELTA = True
+        i += 1
+    elif sys.argv[i] in ("--map", "--robots", "--ships", "--budget") and i + 1 < len(sys.argv):
+        options[sys.argv[i]] = sys.argv[i + 1]
+        i += 2
+    else:
+        args.append(sys.argv[i])
+        i += 1
 
 # 自动判断可执行文件名称
-if len(sys.argv) > 1:
-    STUDENT_CMD = [sys.argv[1]]
+if len(args) > 0:
+    STUDENT_CMD = [args[0]]
 elif platform.system() == "Windows":
     STUDENT_CMD = ["main.exe"]
 else:
     STUDENT_CMD = ["./main"]  # Linux / MacOS
 
 # 设置随机种子
-if len(sys.argv) > 2:
-    random.seed(int(sys.argv[2]))
+if len(args) > 1:
+    random.seed(int(args[1]))
 else:
     random.seed(42)  # 默认固定种子，保证每次运行结果一致
 
+MAP_FILE = options.get("--map", MAP_FILE)
+
+# 二进制协议（与 main.cpp 中的说明一致，小端序）：
+#   协商：判题器发送魔数 "PBN1"，程序回复同样的 4 字节
+#   每帧输入：u32 长度 + (i32 帧号, i32 金钱, u32 货物数, 货物 u16 x/y/价值, 机器人 u16 x/y + u8 带货/状态, 船 i16 状态/泊位)
+#   每帧输出：u32 长度 + 若干 (u8 操作码, u8 方向, u16 编号)
+BINARY_MAGIC = b"PBN1"
+CMD_NAMES = {1: "move", 2: "get", 3: "pull", 4: "go"}
+
+# 增量帧（格式见 main.cpp 的"帧输入输出"一节）：只发送相对上一帧的变化，每 DELTA_KEYFRAME 帧发送一次完整关键帧
+DELTA_KEYFRAME = 100
+
+
+def load_map_file(path):
+    """读取地图；首行若以数字开头则为头部 "行数 列数 [机器人数 船数]"，返回 (地图, 头部)"""
+    with open(path) as f:
+        lines = [line.rstrip("\r\n") for line in f]
+    header = []
+    if lines and lines[0][:1].isdigit():
+        header = [int(t) for t in lines[0].split()]
+        lines = lines[1:]
+    return [list(line) for line in lines if line], header
+
 
 class GameState:
     def __init__(self, map_data):
@@ -36,11 +89,15 @@ class GameState:
         self.robots = []
         self.ships = [{"capacity": 0} for _ in range(SHIP_COUNT)]
         self._init_robots()
+        # 上一次发送给程序的状态，用于计算增量帧
+        self.sent_goods = {}
+        self.sent_robots = []
+        self.sent_ships = []
 
     def _init_robots(self):
         starts = []
-        for r in range(MAP_SIZE):
-            for c in range(MAP_SIZE):
+        for r in range(MAP_ROWS):
+            for c in range(MAP_COLS):
                 if self.map[r][c] == 'A': starts.append((r, c))
         while len(starts) < ROBOT_COUNT: starts.append((0, 0))
         for i in range(ROBOT_COUNT):
@@ -48,12 +105,65 @@ class GameState:
 
     def step_goods(self):
         if len(self.goods) < 50 and random.random() < 0.2:
-            x, y = random.randint(0, MAP_SIZE - 1), random.randint(0, MAP_SIZE - 1)
+            x, y = random.randint(0, MAP_ROWS - 1), random.randint(0, MAP_COLS - 1)
             if self.map[x][y] == '.' and (x, y) not in self.goods:
                 self.goods[(x, y)] = {'val': random.randint(10, 100), 'expire': self.frame + 1000}
         expired = [k for k, v in self.goods.items() if v['expire'] <= self.frame]
         for k in expired: del self.goods[k]
 
+    def _robot_states(self):
+        return [(1 if r['goods'] > 0 else 0, r['x'], r['y'], r['status']) for r in self.robots]
+
+    def _ship_states(self):
+        return [(1, i) for i in range(SHIP_COUNT)]
+
+    def mark_sent(self):
+        """发送关键帧后调用：以当前状态作为下一次增量的基准"""
+        self.sent_goods = {k: v['expire'] for k, v in self.goods.items()}
+        self.sent_robots = self._robot_states()
+        self.sent_ships = self._ship_states()
+
+    def delta_changes(self):
+        """返回 (消失货物, 新增货物, 变化的机器人, 变化的船) 并更新基准。
+        同一格子上的货物被取走后又刷出新货物时，按"旧的消失、新的新增"处理（以过期帧区分），
+        新增货物按字典插入顺序给出，与程序端追加到末尾的顺序一致。"""
+        removed = [k for k, e in self.sent_goods.items() if k not in self.goods or self.goods[k]['expire'] != e]
+        added = [(k, v['val']) for k, v in self.goods.items() if self.sent_goods.get(k) != v['expire']]
+        robots = self._robot_states()
+        ships = self._ship_states()
+        robot_changes = [(i, s) for i, s in enumerate(robots) if s != self.sent_robots[i]]
+        ship_changes = [(i, s) for i, s in enumerate(ships) if s != self.sent_ships[i]]
+        self.sent_goods = {k: v['expire'] for k, v in self.goods.items()}
+        self.sent_robots = robots
+        self.sent_ships = ships
+        return removed, added, robot_changes, ship_changes
+
+    def get_delta_str(self):
+        removed, added, robot_changes, ship_changes = self.delta_changes()
+        lines = [f"D {self.frame} {self.money}", f"{len(removed)}"]
+        lines += [f"{x} {y}" for x, y in removed]
+        lines.append(f"{len(added)}")
+        lines += [f"{x} {y} {val}" for (x, y), val in added]
+        lines.append(f"{len(robot_changes)}")
+        lines += [f"{i} {g} {x} {y} {st}" for i, (g, x, y, st) in robot_changes]
+        lines.append(f"{len(ship_changes)}")
+        lines += [f"{i} {st} {b}" for i, (st, b) in ship_changes]
+        lines.append("OK")
+        return "\n".join(lines) + "\n"
+
+    def get_delta_bytes(self):
+        removed, added, robot_changes, ship_changes = self.delta_changes()
+        parts = [struct.pack("<iiI", self.frame, self.money, len(removed))]
+        parts += [struct.pack("<HH", x, y) for x, y in removed]
+        parts.append(struct.pack("<I", len(added)))
+        parts += [struct.pack("<HHH", x, y, val) for (x, y), val in added]
+        parts.append(struct.pack("<I", len(robot_changes)))
+        parts += [struct.pack("<HHHBB", i, x, y, g, st) for i, (g, x, y, st) in robot_changes]
+        parts.append(struct.pack("<I", len(ship_changes)))
+        parts += [struct.pack("<Hhh", i, st, b) for i, (st, b) in ship_changes]
+        body = b"".join(parts)
+        return struct.pack("<I", len(body) | 0x80000000) + body
+
     def get_input_str(self):
         lines = [f"{self.frame} {self.money}"]
         lines.append(f"{len(self.goods)}")
@@ -66,8 +176,139 @@ class GameState:
         lines.append("OK")
         return "\n".join(lines) + "\n"
 
+    def get_input_bytes(self):
+        parts = [struct.pack("<iiI", self.frame, self.money, len(self.goods))]
+        goods = []
+        for (x, y), v in self.goods.items():
+            goods += (x, y, v['val'])
+        parts.append(struct.pack(f"<{len(goods)}H", *goods))
+        for r in self.robots:
+            parts.append(struct.pack("<HHBB", r['x'], r['y'], 1 if r['goods'] > 0 else 0, r['status']))
+        parts.append(struct.pack(f"<{2 * SHIP_COUNT}h", *[v for i in range(SHIP_COUNT) for v in (1, i)]))
+        body = b"".join(parts)
+        return struct.pack("<I", len(body)) + body
+
+
+def read_exact(stream, n):
+    """从二进制管道读满 n 个字节，进程提前退出时返回 None"""
+    buf = b""
+    while len(buf) < n:
+        chunk = stream.read(n - len(buf))
+        if not chunk: return None
+        buf += chunk
+    return buf
+
+
+class ShmTransport:
+    """共享内存传输（布局与 main.cpp 的"共享内存传输"一节一致）：两个环形缓冲区各传一个方向，
+    每条消息为 u32 长度 + 负载，写完后向对方的 eventfd 写 1 唤醒对方。
+    对外提供与管道相同的 write/flush/read/readline，文本与二进制协议都原样经过它。"""
+    MAGIC = 0x31524853  # "SHR1"
+    DATA_OFFSET = 320
+
+    def __init__(self, capacity=1 << 22, text=True):
+        from multiprocessing import shared_memory
+        self.cap = capacity
+        self.text = text
+        self.shm = shared_memory.SharedMemory(create=True, size=self.DATA_OFFSET + 2 * capacity)
+        self.buf = self.shm.buf
+        self.buf[:self.DATA_OFFSET] = bytes(self.DATA_OFFSET)
+        struct.pack_into("<II", self.buf, 0, self.MAGIC, capacity)
+        self.to_solver = os.eventfd(0)
+        self.to_judge = os.eventfd(0)
+        self.pending = b""
+        self.proc = None
+
+    def solver_args(self):
+        return ["--shm", self.shm.name.lstrip("/"), str(self.to_solver), str(self.to_judge)]
+
+    def _ctl(self, slot, value=None):
+        off = 64 + 64 * slot
+        if value is None: return struct.unpack_from("<Q", self.buf, off)[0]
+        struct.pack_into("<Q", self.buf, off, value)
+
+    def _copy_in(self, ring, pos, data):
+        base = self.DATA_OFFSET + ring * self.cap
+        off = pos % self.cap
+        first = min(len(data), self.cap - off)
+        self.buf[base + off:base + off + first] = data[:first]
+        self.buf[base:base + len(data) - first] = data[first:]
+
+    def _copy_out(self, ring, pos, n):
+        base = self.DATA_OFFSET + ring * self.cap
+        off = pos % self.cap
+        first = min(n, self.cap - off)
+        return bytes(self.buf[base + off:base + off + first]) + bytes(self.buf[base:base + n - first])
+
+    def write(self, data):
+        if isinstance(data, str): data = data.encode()
+        head, tail = self._ctl(0), self._ctl(1)
+        if 4 + len(data) > self.cap - (head - tail):
+            raise RuntimeError("shared memory ring is full")
+        self._copy_in(0, head, struct.pack("<I", len(data)) + data)
+        self._ctl(0, head + 4 + len(data))
+        os.eventfd_write(self.to_solver, 1)
+
+    def flush(self):
+        pass
+
+    def _recv(self):
+        """等待并取出程序发来的消息，程序已退出时返回 False"""
+        while self._ctl(2) == self._ctl(3):
+            ready, _, _ = select.select([self.to_judge], [], [], 1.0)
+            if ready:
+                os.eventfd_read(self.to_judge)
+            elif self.proc.poll() is not None:
+                return False
+        head, tail = self._ctl(2), self._ctl(3)
+        while tail < head:
+            n = struct.unpack("<I", self._copy_out(1, tail, 4))[0]
+            self.pending += self._copy_out(1, tail + 4, n)
+            tail += 4 + n
+        self._ctl(3, tail)
+        return True
+
+    def read(self, n):
+        while len(self.pending) < n and self._recv(): pass
+        data, self.pending = self.pending[:n], self.pending[n:]
+        return data
+
+    def readline(self):
+        while b"\n" not in self.pending and self._recv(): pass
+        k = self.pending.find(b"\n") + 1 or len(self.pending)
+        line, self.pending = self.pending[:k], self.pending[k:]
+        return line.decode() if self.text else line
+
+    def close(self):
+        os.close(self.to_solver)
+        os.close(self.to_judge)
+        self.buf.release()
+        self.shm.close()
+        self.shm.unlink()
+
+
+def read_commands_text(stream):
+    """文本协议：逐行读取指令直到 OK，返回 [(操作, 编号, 参数)]"""
+    commands = []
+    while True:
+        line = stream.readline().strip()
+        if not line or line == "OK": break
+        parts = line.split()
+        commands.append((parts[0], int(parts[1]) if len(parts) > 1 else 0, int(parts[2]) if len(parts) > 2 else 0))
+    return commands
+
+
+def read_commands_binary(stream):
+    """二进制协议：读取长度前缀的指令块，返回 [(操作, 编号, 参数)]"""
+    head = read_exact(stream, 4)
+    if head is None: return []
+    body = read_exact(stream, struct.unpack("<I", head)[0])
+    if body is None: return []
+    return [(CMD_NAMES.get(op, ""), rid, arg) for op, arg, rid in struct.iter_unpack("<BBH", body)]
+
 
 def run_game():
+    global MAP_ROWS, MAP_COLS, ROBOT_COUNT, SHIP_COUNT
     # 0. 检查地图
     if not os.path.exists(MAP_FILE):
         print(f"Error: {MAP_FILE} not found. Run gen_map.py first.")
@@ -82,19 +323,53 @@ def run_game():
         print(f"Linux/Mac: g++ main.cpp -o main")
         return
 
-    with open(MAP_FILE) as f:
-        map_data = [list(line.strip()) for line in f]
+    map_data, header = load_map_file(MAP_FILE)
+    # 规模：命令行参数优先，其次地图头部，最后按地图内容推断 / 默认值
+    MAP_ROWS = header[0] if len(header) > 0 else len(map_data)
+    MAP_COLS = header[1] if len(header) > 1 else len(map_data[0])
+    ROBOT_COUNT = int(options.get("--robots", header[2] if len(header) > 2 else ROBOT_COUNT))
+    SHIP_COUNT = int(options.get("--ships", header[3] if len(header) > 3 else SHIP_COUNT))
+
+    # 非默认地图或规模时把这些参数转交给选手程序（默认情况下不传参，兼容旧版本程序）
+    # 二进制协议不需要传参，由程序根据输入开头的魔数自行切换
+    for opt in ("--map", "--robots", "--ships", "--budget"):
+        if opt in options:
+            STUDENT_CMD.extend([opt, options[opt]])
 
     game = GameState(map_data)
 
     # 2. 启动子进程
     print(f"Starting Process: {STUDENT_CMD[0]}")
+    transport = None
     try:
-        proc = subprocess.Popen(STUDENT_CMD, stdin=subprocess.PIPE, stdout=subprocess.PIPE, text=True, bufsize=1)
+        if SHM:
+            # 共享内存传输：把共享内存名称与两个 eventfd 交给程序，标准输入输出不再使用
+            transport = ShmTransport(text=not BINARY)
+            fds = (transport.to_solver, transport.to_judge)
+            proc = subprocess.Popen(STUDENT_CMD + transport.solver_args(), stdin=subprocess.DEVNULL, pass_fds=fds)
+            transport.proc = proc
+            writer = reader = transport
+        elif BINARY:
+            proc = subprocess.Popen(STUDENT_CMD, stdin=subprocess.PIPE, stdout=subprocess.PIPE, bufsize=0)
+            writer, reader = proc.stdin, proc.stdout
+        else:
+            proc = subprocess.Popen(STUDENT_CMD, stdin=subprocess.PIPE, stdout=subprocess.PIPE, text=True, bufsize=1)
+            writer, reader = proc.stdin, proc.stdout
     except Exception as e:
         print(f"Failed to start student program: {e}")
+        if transport: transport.close()
         return
 
+    # 协商二进制协议：程序必须原样回复魔数
+    if BINARY:
+        writer.write(BINARY_MAGIC)
+        writer.flush()
+        if read_exact(reader, len(BINARY_MAGIC)) != BINARY_MAGIC:
+            print("Error: Student program does not support the binary protocol.")
+            proc.terminate()
+            if transport: transport.close()
+            return
+
     print(f"--- Simulation Start (Total Frames: {MAX_FRAMES}) ---")
 
     try:
@@ -104,30 +379,28 @@ def run_game():
 
             # 发送数据
             try:
-                proc.stdin.write(game.get_input_str())
-                proc.stdin.flush()
+                if DELTA and frame % DELTA_KEYFRAME != 1:
+                    data = game.get_delta_bytes() if BINARY else game.get_delta_str()
+                else:
+                    data = game.get_input_bytes() if BINARY else game.get_input_str()
+                    game.mark_sent()
+                writer.write(data)
+                writer.flush()
             except BrokenPipeError:
                 print("Error: Student program exited unexpectedly.")
                 break
 
             # 接收指令
-            commands = []
-            while True:
-                line = proc.stdout.readline().strip()
-                if not line or line == "OK": break
-                commands.append(line)
+            commands = read_commands_binary(reader) if BINARY else read_commands_text(reader)
 
             # 处理逻辑 (与Python版一致)
             next_pos = {}
-            for cmd in commands:
-                parts = cmd.split()
-                if not parts: continue
-                if parts[0] == "move":
-                    rid, d = int(parts[1]), int(parts[2])
+            for action, rid, d in commands:
+                if action == "move":
                     r = game.robots[rid]
                     dx, dy = {0: (0, 1), 1: (0, -1), 2: (-1, 0), 3: (1, 0)}.get(d, (0, 0))
                     nx, ny = r['x'] + dx, r['y'] + dy
-                    if 0 <= nx < MAP_SIZE and 0 <= ny < MAP_SIZE and game.map[nx][ny] not in ['#', '*']:
+                    if 0 <= nx < MAP_ROWS and 0 <= ny < MAP_COLS and game.map[nx][ny] not in ['#', '*']:
                         next_pos[rid] = (nx, ny)
 
             current_occupied = set((r['x'], r['y']) for r in game.robots)
@@ -139,24 +412,19 @@ def run_game():
                     game.robots[rid]['x'], game.robots[rid]['y'] = nx, ny
                     current_occupied.add((nx, ny))
 
-            for cmd in commands:
-                parts = cmd.split()
-                if not parts: continue
-                action = parts[0]
+            for action, rid, _ in commands:
                 if action == "get":
-                    rid = int(parts[1])
                     r = game.robots[rid]
                     if r['goods'] == 0 and (r['x'], r['y']) in game.goods:
                         val = game.goods.pop((r['x'], r['y']))['val']
                         r['goods'] = val
                 elif action == "pull":
-                    rid = int(parts[1])
                     r = game.robots[rid]
                     if r['goods'] > 0 and game.map[r['x']][r['y']] == 'B':
                         game.ships[0]['capacity'] += r['goods']
                         r['goods'] = 0
                 elif action == "go":
-                    sid = int(parts[1])
+                    sid = rid
                     profit = game.ships[sid]['capacity']
                     game.money += profit
                     game.ships[sid]['capacity'] = 0
@@ -168,6 +436,9 @@ def run_game():
         print(f"Runtime Error: {e}")
     finally:
         proc.terminate()
+        if transport:
+            proc.wait()
+            transport.close()
         print(f"--- Game Over ---")
         print(f"Final Score: {game.money}")
 
@@ -1,25 +1,66 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <queue>
 #include <cmath>
 #include <fstream>
 #include <algorithm>
 #include <cstring>
+#include <functional>
+#include <sstream>
+#include <cctype>
+#include <chrono>
+#include <deque>
+#include <cstdio>
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#define IO_READ _read
+#define IO_WRITE _write
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdint.h>
+#define IO_READ read
+#define IO_WRITE write
+#endif
 
 using namespace std;
 
-// 地图大小常量：100x100的网格
-const int N = 100;
-// 机器人数量：10个
-const int ROBOT_NUM = 10;
-// 船只数量：5艘
-const int SHIP_NUM = 5;
+// 地图与舰队规模：默认 100x100 的网格、10个机器人、5艘船。
+// 可由地图文件首行的头部 "行数 列数 机器人数 船数" 或命令行参数覆盖（命令行优先），
+// 没有头部时地图尺寸按文件内容推断。所有按尺寸分配的数组都在 load_map 中分配。
+int N = 100;                 // 地图列数，也是格子编号 x*N+y 的行宽
+int MAP_ROWS = 100;          // 地图行数
+int CELL_COUNT = 100 * 100;  // 格子总数 MAP_ROWS*N
+// 机器人数量
+int ROBOT_NUM = 10;
+// 船只数量
+int SHIP_NUM = 5;
+string map_path = "maps/map1.txt";  // 地图文件路径，命令行 --map 设置
 
 // 货物结构体：存储货物的基本信息
 struct Goods {
     int x, y;    // 货物在地图上的坐标
     int val;     // 货物的价值
+    int comp;    // 货物所在的连通块编号
+    int id;      // 货物在登记表中的稳定ID（跨帧不变）
+};
+
+// D* Lite 增量搜索状态：每个机器人持有一份，跨帧保留
+// 从目标反向搜索，目标不变时只根据变化的占用格子修复，不必每帧重新搜索
+// 不保存路径：跨帧保留的是 g/rhs 值，每帧沿 g 值下降取第一步
+struct DStarLite {
+    int target = -1;                 // 当前搜索的目标结点，-1表示尚未初始化
+    int last_start = -1;             // 上次规划时的起点
+    int km = 0;                      // 起点移动带来的键值修正量
+    vector<int> g, rhs;              // 各结点的 g 值与一步前瞻值 rhs（按压缩可走图的结点编号索引）
+    vector<pair<int, int>> key;      // 结点在开放列表中的当前键
+    vector<char> in_open;            // 是否在开放列表中
+    vector<char> blocked;            // 上次规划时视为动态障碍的结点
+    vector<int> blocked_list;        // 同上，列表形式
+    vector<pair<pair<int, int>, int>> open;  // 开放列表（惰性删除的最小堆）
 };
 
 // 机器人结构体：存储机器人的状态信息
@@ -27,8 +68,10 @@ struct Robot {
     int has_goods;       // 是否携带货物（0:无，1:有）
     int x, y;            // 机器人在地图上的当前坐标
     int status;          // 机器人的状态（0:不可用/损坏，其他:可用）
+    int comp = -1;       // 机器人所在的连通块编号
     int last_x = -1, last_y = -1;  // 上一帧的坐标，用于检测机器人是否卡住
     int stuck_count = 0;            // 卡住计数器，记录连续多少帧位置未变化
+    DStarLite search;               // 持久化的增量搜索状态（--planner dstar 时使用）
 };
 
 // 船只结构体：存储船只的状态信息
@@ -39,7 +82,7 @@ struct Ship {
 
 // 候选分配结构体：用于贪心算法中评估机器人-货物分配的优劣
 struct Candidate {
-    int robot_id;     // 机器人的ID（0-9）
+    int robot_id;     // 机器人的ID（0..ROBOT_NUM-1）
     int good_idx;     // 货物在goods_list中的索引
     double score;     // 评分：价值/(距离+1)，用于贪心选择
     // 重载<运算符，实现按评分降序排序（评分高的排在前面）
@@ -50,378 +93,3060 @@ struct Candidate {
 
 // 全局变量定义
 int frame_id, money;                    // 当前帧ID和当前拥有的金钱
-char grid[N][N];                        // 地图网格，存储地图上的障碍物、泊位等信息
-bool occupied[N][N];                    // 占用标记，用于机器人碰撞避免，记录每个位置是否有机器人
+vector<int> occupied_list;              // 本帧被标记过占用的格子（x*N+y，可能重复或已被临时释放）
+vector<int> comp_id;                    // comp_id[x*N+y]：连通块编号（按静态地形四连通划分），障碍/海洋为-1
 vector<Goods> goods_list;               // 当前地图上所有货物的列表
-vector<Robot> robots(ROBOT_NUM);        // 所有机器人的列表
-vector<Ship> ships(SHIP_NUM);           // 所有船只的列表
+vector<Robot> robots;                   // 所有机器人的列表（load_map 时按 ROBOT_NUM 分配）
+vector<Ship> ships;                     // 所有船只的列表（load_map 时按 SHIP_NUM 分配）
 vector<pair<int, int>> berths;          // 所有泊位的坐标列表
-int berth_dist[N][N];                   // 每个点到最近泊位的距离
+vector<int> berth_dist;                 // berth_dist[x*N+y]：每个点到最近泊位的距离
+vector<int> nearest_berth;              // nearest_berth[x*N+y]：每个点按真实行走距离最近的泊位编号，-1表示不可达
+vector<vector<int>> berth_each_dist;    // berth_each_dist[b][x*N+y]：点(x,y)到泊位b的真实距离，-1表示不可达；空表示尚未计算
+vector<signed char> berth_next_dir;     // berth_next_dir[x*N+y]：从(x,y)走向最近泊位的下一步方向，-1表示已到达或不可达
+double good_field_cost_ms = 0;          // 计算一张全图距离场的预估耗时（毫秒）：按泊位与货物距离场的实测耗时滑动平均
 
 // 方向数组：定义四个移动方向
 // 0:右，1:左，2:上，3:下
-int dx[] = {0, 0, -1, 1};
-int dy[] = {1, -1, 0, 0};
+constexpr int dx[] = {0, 0, -1, 1};
+constexpr int dy[] = {1, -1, 0, 0};
 
-// 计算每个点到最近泊位的距离（多源BFS）
-void init_berth_dist() {
-    memset(berth_dist, -1, sizeof(berth_dist));
-    queue<pair<int, int>> q;
-    for (auto& b : berths) {
-        berth_dist[b.first][b.second] = 0;
-        q.push(b);
-    }
+// ========== 地图尺寸特化 ==========
+// 地图存成带一圈墙的扁平网格：格子(x,y)位于下标 (x+1)*stride+(y+1)，边框全部是墙，
+// 四个方向的邻居就是下标加上一个线性偏移，越界的邻居自然落在墙上，邻居检查不需要边界判断。
+// 常见尺寸用 Dims<W,H> 实例化，行宽、偏移和每行位图字数都是编译期常量；
+// Dims<0,0> 是运行时尺寸的通用版本。with_dims() 按实际尺寸选择实例化后调用核心例程。
+// 目前只有建图（BuildGraphKernel）和波前BFS（WavefrontKernel）按尺寸特化：各种逐次搜索都在压缩可走图上
+// 通过邻接表与 node_pad 访问邻居和占用，内层循环里没有与地图尺寸相关的偏移，特化不会改变它们的代码。
+template <int W, int H>
+struct Dims {
+    static constexpr int STRIDE = H + 2;
+    constexpr int rows() const { return W; }
+    constexpr int cols() const { return H; }
+    constexpr int stride() const { return STRIDE; }
+    constexpr int padded() const { return (W + 2) * STRIDE; }
+    constexpr int words() const { return (H + 63) / 64; }
+    constexpr int pad(int x, int y) const { return (x + 1) * STRIDE + y + 1; }
+    // 方向 d 的线性偏移，方向编号与 dx/dy 一致
+    constexpr int delta(int d) const { return d == 0 ? 1 : d == 1 ? -1 : d == 2 ? -STRIDE : STRIDE; }
+};
 
-    while (!q.empty()) {
-        auto curr = q.front();
-        q.pop();
-        int cx = curr.first;
-        int cy = curr.second;
+template <>
+struct Dims<0, 0> {
+    int w, h;
+    int rows() const { return w; }
+    int cols() const { return h; }
+    int stride() const { return h + 2; }
+    int padded() const { return (w + 2) * (h + 2); }
+    int words() const { return (h + 63) / 64; }
+    int pad(int x, int y) const { return (x + 1) * (h + 2) + y + 1; }
+    int delta(int d) const { return d == 0 ? 1 : d == 1 ? -1 : d == 2 ? -(h + 2) : h + 2; }
+};
 
-        for (int i = 0; i < 4; i++) {
-            int nx = cx + dx[i];
-            int ny = cy + dy[i];
-            if (nx >= 0 && nx < N && ny >= 0 && ny < N &&
-                grid[nx][ny] != '*' && grid[nx][ny] != '#' &&
-                berth_dist[nx][ny] == -1) {
-                berth_dist[nx][ny] = berth_dist[cx][cy] + 1;
-                q.push({nx, ny});
+// 按地图尺寸分派到对应的实例化：kernel 为带模板 operator()(const Dims&) 的函数对象
+template <class Kernel>
+void with_dims(int w, int h, Kernel& kernel) {
+    if (w == 100 && h == 100) kernel(Dims<100, 100>());
+    else if (w == 200 && h == 200) kernel(Dims<200, 200>());
+    else if (w == 400 && h == 400) kernel(Dims<400, 400>());
+    else kernel(Dims<0, 0>{w, h});
+}
+
+// 扁平网格每格一个字节：CELL_WALL 为静态不可走（边框、海洋'*'、障碍'#'），CELL_OCCUPIED 为本帧机器人占用
+const unsigned char CELL_WALL = 1;
+const unsigned char CELL_OCCUPIED = 2;
+int GRID_STRIDE = N + 2;
+vector<unsigned char> cell_flags;   // (MAP_ROWS+2)*GRID_STRIDE，load_map 时分配
+
+inline int pad_of(int x, int y) {
+    return (x + 1) * GRID_STRIDE + y + 1;
+}
+
+// 判断(x,y)的静态地形是否可走（不考虑机器人占用）
+inline bool static_passable(int x, int y) {
+    return !(cell_flags[pad_of(x, y)] & CELL_WALL);
+}
+
+inline bool occupied_at(int x, int y) {
+    return cell_flags[pad_of(x, y)] & CELL_OCCUPIED;
+}
+
+// 按格子编号 x*N+y 读取占用标记
+inline bool occupied_cell(int c) {
+    return occupied_at(c / N, c % N);
+}
+
+inline void release_occupied(int x, int y) {
+    cell_flags[pad_of(x, y)] &= ~CELL_OCCUPIED;
+}
+
+// ========== 压缩可走图 ==========
+// load_map 时把所有可走格子重新编号为稠密的结点编号 0..V-1，
+// 并为每个结点保存固定4个槽位的邻接表（按方向 0-3，-1 为越界或不可走的哨兵）。
+// 搜索在结点上进行，内层循环不再需要边界检查和地形字符比较，工作区数组也只需覆盖可走格子。
+int node_count = 0;                 // 结点数 V
+vector<int> node_of;                // 格子编号 -> 结点编号，-1表示不可走
+vector<int> cell_of;                // 结点编号 -> 格子编号
+vector<int> node_pad;               // 结点编号 -> 扁平网格下标
+vector<short> node_x, node_y;       // 结点编号 -> 坐标
+vector<int> adj;                    // adj[4*v+d]：结点 v 在方向 d 上的相邻结点，-1为哨兵
+
+// 建图核心：在带墙扁平网格上按线性偏移取邻居，墙上的结点编号为-1，正好就是哨兵
+struct BuildGraphKernel {
+    template <class D>
+    void operator()(const D& dims) {
+        vector<int> node_at(dims.padded(), -1);
+        node_count = 0;
+        cell_of.clear();
+        node_pad.clear();
+        node_x.clear();
+        node_y.clear();
+        for (int x = 0; x < dims.rows(); x++) {
+            for (int y = 0; y < dims.cols(); y++) {
+                int p = dims.pad(x, y);
+                if (cell_flags[p] & CELL_WALL) {
+                    node_of[x * N + y] = -1;
+                    continue;
+                }
+                node_at[p] = node_count;
+                node_of[x * N + y] = node_count++;
+                cell_of.push_back(x * N + y);
+                node_pad.push_back(p);
+                node_x.push_back(x);
+                node_y.push_back(y);
             }
         }
+        adj.resize(4 * node_count);
+        for (int v = 0; v < node_count; v++) {
+            for (int d = 0; d < 4; d++) adj[4 * v + d] = node_at[node_pad[v] + dims.delta(d)];
+        }
     }
+};
+
+void build_graph() {
+    BuildGraphKernel kernel;
+    with_dims(MAP_ROWS, N, kernel);
 }
 
-// 加载地图文件
-// 从maps/map1.txt读取地图数据，并初始化泊位列表
-void load_map() {
-    ifstream in("maps/map1.txt");
-    if (!in) {
-        cerr << "地图加载失败!" << endl;
-        return;
+// 结点 v 当前是否被机器人占用
+inline bool node_occupied(int v) {
+    return cell_flags[node_pad[v]] & CELL_OCCUPIED;
+}
+
+// 标记(x,y)被占用，并记入 occupied_list（增量搜索据此得知哪些格子的占用发生了变化）
+inline void mark_occupied(int x, int y) {
+    cell_flags[pad_of(x, y)] |= CELL_OCCUPIED;
+    occupied_list.push_back(x * N + y);
+}
+
+// ========== 帧时间预算 ==========
+// read_frame_data() 返回时开始计时（单调时钟），各阶段在开始一段较贵的工作前检查是否已到期限：
+// 候选生成、拍卖出价、CBS 与逐机器人规划到期后停止细化，改用已有结果或廉价的后备动作
+// （运货沿泊位距离场下降，取货沿已缓存的货物距离场下降），保证本帧按时输出。
+// 单次就可能超出预算的工作（大地图上计算一张货物距离场）先用 frame_can_afford 按预估耗时判断，放不下就推迟。
+// 发生过截断的帧记为降级帧，实际耗时超过预算的帧记为超时帧，二者每100帧及程序结束时输出到 cerr
+// （判题器在最后一帧后会直接结束进程，因此不能只在结束时报告）。
+// 启动预计算中可以少算或推迟到帧内的部分共用 SETUP_BUDGET_FRAMES 帧的预算，用 setup_can_afford 判断。
+double frame_budget_ms = 40.0;          // 每帧时间预算（毫秒），0表示不限；命令行 --budget MS
+chrono::steady_clock::time_point frame_start;
+bool frame_degraded = false;            // 本帧是否发生过截断
+int degraded_frames = 0;                // 降级帧累计数
+int overrun_frames = 0;                 // 超时帧累计数（实际耗时超过预算）
+double max_frame_ms = 0;                // 单帧最长耗时
+bool frame_report = true;               // 是否每100帧输出统计（模拟器快进时关闭）
+const int SETUP_BUDGET_FRAMES = 100;
+chrono::steady_clock::time_point setup_start;   // solver_init 开始时刻
+
+inline void frame_timer_start() {
+    frame_start = chrono::steady_clock::now();
+    frame_degraded = false;
+}
+
+inline double frame_elapsed_ms() {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - frame_start).count();
+}
+
+// 是否已到本帧期限；调用方据此放弃后续细化，因此到期即记为降级帧
+inline bool frame_deadline_passed() {
+    if (frame_budget_ms <= 0 || frame_elapsed_ms() < frame_budget_ms) return false;
+    frame_degraded = true;
+    return true;
+}
+
+// 本帧剩余时间是否还放得下一段预估耗时 est_ms 的工作（占到预算的 share 为止）；放不下记为降级帧
+inline bool frame_can_afford(double est_ms, double share = 1.0) {
+    if (frame_budget_ms <= 0 || frame_elapsed_ms() + est_ms <= frame_budget_ms * share) return true;
+    frame_degraded = true;
+    return false;
+}
+
+// 启动预计算还放得下一段预估耗时 est_ms 的工作（占到启动预算的 share 为止）
+inline bool setup_can_afford(double est_ms, double share = 1.0) {
+    double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - setup_start).count();
+    return frame_budget_ms <= 0 || elapsed + est_ms <= frame_budget_ms * SETUP_BUDGET_FRAMES * share;
+}
+
+// 帧结束时调用：统计降级帧、超时帧与最长耗时
+inline void frame_timer_finish() {
+    double ms = frame_elapsed_ms();
+    if (frame_degraded) degraded_frames++;
+    if (frame_budget_ms > 0 && ms > frame_budget_ms) overrun_frames++;
+    max_frame_ms = max(max_frame_ms, ms);
+    if (frame_report && frame_id % 100 == 0) {
+        cerr << "Frame " << frame_id << ": 降级帧数 = " << degraded_frames << "，超时帧数 = " << overrun_frames
+             << "，单帧最长耗时 = " << max_frame_ms << " ms" << endl;
     }
-    // 读取100x100的地图网格
-    for (int i = 0; i < N; i++) {
-        for (int j = 0; j < N; j++) {
-            in >> grid[i][j];
-            // 如果该位置是泊位（标记为'B'），则记录其坐标
-            if (grid[i][j] == 'B') {
-                berths.push_back({i, j});
+}
+
+// ========== 位并行波前BFS ==========
+// 每行的可走格子存成若干个64位字的位图（第y位对应第y列），整层前沿用移位/与/或一次性扩展：
+//   下一层 = (左右移一位 | 上一行 | 下一行) & 可走 & ~已访问
+// 每扩展一层把新置位的格子距离记为当前层数。适合批量计算整张图的距离场。
+// 每层都要扫描前沿所在行带的全部字，总代价是 O(行带 × 每行字数 × 层数)；大地图上层数与行带都随边长增长，
+// 会比逐格的队列 BFS 更慢。因此累计扫描的字数超过 WAVE_WORK_LIMIT × 格子数 时，以当前前沿为起点
+// 改用压缩可走图上的队列 BFS 完成剩余部分（结果完全相同），总代价不超过两者中较小者的常数倍。
+typedef unsigned long long Word;
+const double WAVE_WORK_LIMIT = 1.0;
+vector<Word> passable_bits;     // 静态可走位图（不含机器人占用），第x行第w个字位于 x*words+w，load_map 时构建
+
+// 波前扩展用的位图工作区（全局复用，布局同 passable_bits）
+vector<Word> wave_visited;
+vector<Word> wave_front;
+vector<Word> wave_next;
+vector<int> wave_queue;         // 改用队列 BFS 时的结点队列
+
+// 波前改用队列 BFS：front 中第 row_lo..row_hi 行置位的格子是最近一层，从它们继续逐结点扩展
+void wavefront_finish_bfs(const Word* front, int row_lo, int row_hi, int W, int* dist) {
+    wave_queue.clear();
+    for (int r = row_lo; r <= row_hi; r++) {
+        for (int w = 0; w < W; w++) {
+            for (Word m = front[r * W + w]; m; m &= m - 1) {
+                wave_queue.push_back(node_of[r * N + (w << 6) + __builtin_ctzll(m)]);
+            }
+        }
+    }
+    for (size_t h = 0; h < wave_queue.size(); h++) {
+        int v = wave_queue[h];
+        int dv = dist[cell_of[v]] + 1;
+        for (int d = 0; d < 4; d++) {
+            int u = adj[4 * v + d];
+            if (u >= 0 && dist[cell_of[u]] == -1) {
+                dist[cell_of[u]] = dv;
+                wave_queue.push_back(u);
             }
         }
     }
-    in.close();
 }
 
-// 读取每一帧的数据
-// 从标准输入读取当前帧的游戏状态数据
-// 返回值：成功读取返回true，读取失败（游戏结束）返回false
-bool read_frame_data() {
-    // 读取帧ID和当前金钱
-    if (!(cin >> frame_id >> money)) return false;
-    
-    int k;
-    cin >> k;  // 读取当前帧的货物数量
-    // 读取所有货物的信息（坐标和价值）
-    goods_list.resize(k);
-    for (int i = 0; i < k; i++) {
-        cin >> goods_list[i].x >> goods_list[i].y >> goods_list[i].val;
-    }
-    
-    // 读取所有机器人的状态信息
-    for (int i = 0; i < ROBOT_NUM; i++) {
-        cin >> robots[i].has_goods >> robots[i].x >> robots[i].y >> robots[i].status;
-    }
-    
-    // 读取所有船只的状态信息
-    for (int i = 0; i < SHIP_NUM; i++) {
-        cin >> ships[i].status >> ships[i].berth_id;
+// 根据扁平网格构建可走位图
+void build_passable_bits() {
+    int words = (N + 63) / 64;
+    passable_bits.assign(MAP_ROWS * words, 0);
+    wave_visited.assign(MAP_ROWS * words, 0);
+    wave_front.assign(MAP_ROWS * words, 0);
+    wave_next.assign(MAP_ROWS * words, 0);
+    for (int x = 0; x < MAP_ROWS; x++) {
+        for (int y = 0; y < N; y++) {
+            if (static_passable(x, y)) passable_bits[x * words + (y >> 6)] |= 1ULL << (y & 63);
+        }
     }
-    
-    string s;
-    cin >> s; // 读取 "OK" 确认标志，表示帧数据读取完成
-    return true;
 }
 
-// 使用BFS（广度优先搜索）算法寻找从起点到目标位置的下一步移动方向
-// 参数：
-//   start_x, start_y: 起点坐标
-//   target_x, target_y: 目标坐标
-// 返回值：
-//   0-3: 表示移动方向（右、左、上、下）
-//   -1: 表示已在目标位置或无法到达目标
-int bfs(int start_x, int start_y, int target_x, int target_y) {
-    // 如果已经在目标位置，返回-1
-    if (start_x == target_x && start_y == target_y) return -1;
+// 波前核心：每行字数 W 对固定尺寸是编译期常量，内层按字的循环可以完全展开
+struct WavefrontKernel {
+    const vector<int>* sources;
+    int* dist;
 
-    queue<pair<int, int>> q;
-    q.push({start_x, start_y});
-    
-    // parent数组记录每个位置的父节点，用于回溯路径
-    vector<vector<pair<int, int>>> parent(N, vector<pair<int, int>>(N, {-1, -1}));
-    // visited数组记录每个位置是否已被访问
-    vector<vector<bool>> visited(N, vector<bool>(N, false));
-    
-    visited[start_x][start_y] = true;
-    
-    bool found = false;
-    // BFS搜索主循环
-    while (!q.empty()) {
-        auto curr = q.front();
-        q.pop();
-        int cx = curr.first;
-        int cy = curr.second;
+    template <class D>
+    void operator()(const D& dims) {
+        const int R = dims.rows(), C = dims.cols(), W = dims.words();
+        Word* vis = wave_visited.data();
+        Word* front = wave_front.data();
+        Word* next = wave_next.data();
+        const Word* pass = passable_bits.data();
+        for (int c = 0; c < R * C; c++) dist[c] = -1;
+        fill(vis, vis + R * W, 0);
+        fill(front, front + R * W, 0);
 
-        // 找到目标位置
-        if (cx == target_x && cy == target_y) {
-            found = true;
-            break;
+        int row_lo = R, row_hi = -1;  // 当前前沿所在的行范围，逐层向外扩一行
+        for (int c : *sources) {
+            int x = c / C, y = c % C;
+            if (!(pass[x * W + (y >> 6)] >> (y & 63) & 1)) continue;
+            front[x * W + (y >> 6)] |= 1ULL << (y & 63);
+            vis[x * W + (y >> 6)] |= 1ULL << (y & 63);
+            dist[c] = 0;
+            row_lo = min(row_lo, x);
+            row_hi = max(row_hi, x);
         }
 
-        // 尝试向四个方向移动
-        for (int i = 0; i < 4; i++) {
-            int nx = cx + dx[i];
-            int ny = cy + dy[i];
-
-            // 检查边界和是否已访问
-            if (nx >= 0 && nx < N && ny >= 0 && ny < N && !visited[nx][ny]) {
-                // 检查障碍物和动态占用情况
-                // '*'和'#'表示障碍物，occupied表示有其他机器人占用
-                if (grid[nx][ny] != '*' && grid[nx][ny] != '#' && !occupied[nx][ny]) {
-                    visited[nx][ny] = true;
-                    parent[nx][ny] = {cx, cy};
-                    q.push({nx, ny});
+        long long work = 0, work_limit = (long long)(WAVE_WORK_LIMIT * R * C);
+        for (int layer = 1; row_lo <= row_hi; layer++) {
+            int lo = max(row_lo - 1, 0), hi = min(row_hi + 1, R - 1);
+            work += (long long)(hi - lo + 1) * W;
+            if (work > work_limit) {
+                wavefront_finish_bfs(front, row_lo, row_hi, W, dist);
+                return;
+            }
+            int new_lo = R, new_hi = -1;
+            for (int r = lo; r <= hi; r++) {
+                const Word* f = front + r * W;
+                Word any = 0;
+                for (int w = 0; w < W; w++) {
+                    // 同一行左右相邻：左移（列+1）带入低位字的最高位，右移（列-1）带入高位字的最低位
+                    Word m = (f[w] << 1) | (f[w] >> 1);
+                    if (w > 0) m |= f[w - 1] >> 63;
+                    if (w + 1 < W) m |= f[w + 1] << 63;
+                    // 上下相邻行
+                    if (r > 0) m |= f[w - W];
+                    if (r + 1 < R) m |= f[w + W];
+                    m &= pass[r * W + w] & ~vis[r * W + w];
+                    next[r * W + w] = m;
+                    any |= m;
+                }
+                if (any) {
+                    new_lo = min(new_lo, r);
+                    new_hi = max(new_hi, r);
+                }
+            }
+            // 记录新一层的距离，并把它作为下一轮的前沿
+            for (int r = lo; r <= hi; r++) {
+                for (int w = 0; w < W; w++) {
+                    Word m = next[r * W + w];
+                    vis[r * W + w] |= m;
+                    while (m) {
+                        int y = (w << 6) + __builtin_ctzll(m);
+                        dist[r * C + y] = layer;
+                        m &= m - 1;
+                    }
                 }
             }
+            copy(next + lo * W, next + (hi + 1) * W, front + lo * W);
+            row_lo = new_lo;
+            row_hi = new_hi;
         }
     }
+};
 
-    // 如果未找到路径，返回-1
-    if (!found) return -1;
+// 计算从 sources（格子编号 x*N+y）出发的多源距离场，写入 dist（长度 CELL_COUNT，不可达为-1）
+void wavefront_field(const vector<int>& sources, int* dist) {
+    WavefrontKernel kernel;
+    kernel.sources = &sources;
+    kernel.dist = dist;
+    with_dims(MAP_ROWS, N, kernel);
+}
 
-    // 从目标位置回溯到起点，找到第一步的移动方向
-    int curr_x = target_x;
-    int curr_y = target_y;
-    while (true) {
-        pair<int, int> p = parent[curr_x][curr_y];
-        // 如果父节点是起点，说明找到了紧邻起点的下一步位置
-        if (p.first == start_x && p.second == start_y) {
-            // 确定移动方向
-            for (int i = 0; i < 4; i++) {
-                if (start_x + dx[i] == curr_x && start_y + dy[i] == curr_y) {
-                    return i;
-                }
+// 计算一张泊位距离场，并把耗时计入全图距离场的预估耗时
+void build_berth_field(int b) {
+    auto t0 = chrono::steady_clock::now();
+    berth_each_dist[b].resize(CELL_COUNT);
+    wavefront_field(vector<int>(1, berths[b].first * N + berths[b].second), berth_each_dist[b].data());
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    good_field_cost_ms = good_field_cost_ms > 0 ? good_field_cost_ms * 0.75 + ms * 0.25 : ms;
+}
+
+// 计算最近泊位距离场与下一步方向表
+// 以全部泊位为源做一次波前BFS得到 berth_dist（其耗时作为全图距离场预估耗时的初值）；
+// 再按距离从小到大推出 nearest_berth：每个点取所有能让距离减1的邻居中最小的泊位编号，
+// 即所有最近泊位中编号最小的一个（与逐个泊位比较距离、相等取小编号的结果相同）。
+// berth_next_dir 取方向编号最小的、距离减1且最近泊位相同的邻居，它也是朝该泊位的最短路方向，
+// 运货阶段查表 O(1) 得到目标泊位和移动方向。
+void init_berth_dist() {
+    int B = berths.size();
+    berth_each_dist.assign(B, vector<int>());
+    berth_dist.assign(CELL_COUNT, -1);
+    nearest_berth.assign(CELL_COUNT, -1);
+    berth_next_dir.assign(CELL_COUNT, -1);
+    good_field_cost_ms = 0;
+    if (B == 0) return;
+
+    vector<int> sources;
+    for (int b = 0; b < B; b++) sources.push_back(berths[b].first * N + berths[b].second);
+    auto t0 = chrono::steady_clock::now();
+    wavefront_field(sources, berth_dist.data());
+    good_field_cost_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    for (int b = B - 1; b >= 0; b--) if (berth_dist[sources[b]] == 0) nearest_berth[sources[b]] = b;
+    // 按距离计数排序后逐层传播最近泊位编号
+    int max_d = 0;
+    for (int v = 0; v < node_count; v++) max_d = max(max_d, berth_dist[cell_of[v]]);
+    vector<int> start(max_d + 2, 0), order(node_count);
+    for (int v = 0; v < node_count; v++) if (berth_dist[cell_of[v]] >= 0) start[berth_dist[cell_of[v]] + 1]++;
+    for (int d = 0; d <= max_d; d++) start[d + 1] += start[d];
+    for (int v = 0; v < node_count; v++) if (berth_dist[cell_of[v]] >= 0) order[start[berth_dist[cell_of[v]]]++] = v;
+    for (int k = 0; k < start[max_d]; k++) {
+        int v = order[k], c = cell_of[v], d = berth_dist[c];
+        if (d == 0) continue;
+        for (int i = 0; i < 4; i++) {
+            int u = adj[4 * v + i];
+            if (u == -1 || berth_dist[cell_of[u]] != d - 1) continue;
+            int nb = nearest_berth[cell_of[u]];
+            if (nearest_berth[c] == -1 || nb < nearest_berth[c]) {
+                nearest_berth[c] = nb;
+                berth_next_dir[c] = i;
             }
         }
-        curr_x = p.first;
-        curr_y = p.second;
+    }
+}
+
+// 计算各泊位的距离场：作为协作规划、CBS 与寻路的启发
+// 在地标之后用启动预算的剩余部分计算，放不下的留空，由 get_berth_field 在帧内按需计算
+void init_berth_fields() {
+    for (int b = 0; b < (int)berths.size(); b++) {
+        if (!setup_can_afford(good_field_cost_ms)) break;
+        build_berth_field(b);
+    }
+}
+
+// 在距离场 dist 上做梯度下降：选一个能让距离减1且未被占用的邻居
+// 返回值：0-3为移动方向，-1表示已到达、不可达或所有下降方向都被占用
+int descend_step(const int* dist, int x, int y) {
+    int d = dist[x * N + y];
+    if (d <= 0) return -1;
+    const int* nb = &adj[4 * node_of[x * N + y]];
+    for (int i = 0; i < 4; i++) {
+        if (nb[i] == -1) continue;
+        int c = cell_of[nb[i]];
+        if (dist[c] == d - 1 && !occupied_cell(c)) return i;
     }
     return -1;
 }
 
-int main() {
-    // 加载地图数据
-    load_map();
-    init_berth_dist(); // 预计算泊位距离场
-    
-    // 主循环：处理每一帧的游戏数据
-    while (read_frame_data()) {
-        // 初始化占用地图，标记当前所有机器人的位置
-        memset(occupied, 0, sizeof(occupied));
-        for(int i=0; i<ROBOT_NUM; i++) {
-            occupied[robots[i].x][robots[i].y] = true;
+// 已计算的泊位距离场，未计算时返回 nullptr
+const int* peek_berth_field(int b) {
+    return berth_each_dist[b].empty() ? nullptr : berth_each_dist[b].data();
+}
+
+// 获取泊位距离场，未计算时在本帧预算放得下时计算，否则返回 nullptr
+const int* get_berth_field(int b) {
+    if (berth_each_dist[b].empty() && frame_can_afford(good_field_cost_ms)) build_berth_field(b);
+    return peek_berth_field(b);
+}
+
+// 查表得到从(x,y)朝最近泊位b走一步的方向
+// 优先使用预计算的方向；若该格被其他机器人占用，则尝试其他同样朝泊位b让距离减1的方向
+// （距离减1且最近泊位仍为b的邻居）。b 不是(x,y)的最近泊位时沿泊位b的距离场下降（未计算时返回-1）。
+// 返回值：0-3为移动方向，-1表示所有最短路方向都被占用（或已在泊位/不可达）
+int berth_step(int b, int x, int y) {
+    int c = x * N + y;
+    if (nearest_berth[c] != b) {
+        const int* field = peek_berth_field(b);
+        return field ? descend_step(field, x, y) : -1;
+    }
+    int best = berth_next_dir[c];
+    if (best == -1) return -1;
+    if (!occupied_at(x + dx[best], y + dy[best])) return best;
+    const int* nb = &adj[4 * node_of[c]];
+    for (int i = 0; i < 4; i++) {
+        if (nb[i] == -1) continue;
+        int u = cell_of[nb[i]];
+        if (berth_dist[u] == berth_dist[c] - 1 && nearest_berth[u] == b && !occupied_cell(u)) return i;
+    }
+    return -1;
+}
+
+// ========== 货物登记表 ==========
+// 判题器每帧重新发送全部货物，这里按坐标把它们对应到跨帧稳定的货物ID：
+// good_id_at 以格子编号 x*N+y 为键（地图上同一格最多一个货物，格子编号即完美哈希），
+// 每帧把输入与上一帧对比，得到新出现、消失、不变三类事件供各模块增量更新；
+// 同一格上价值不同的货物视为旧货物消失、新货物出现。
+// 货物在出现后第 GOOD_LIFETIME 帧被判题器移除，评分时据此排除来不及取到的货物。
+const int GOOD_LIFETIME = 1000;
+
+struct GoodRecord {
+    int cell;          // 坐标 x*N+y
+    int val;           // 价值
+    int first_seen;    // 首次出现的帧号
+    int last_seen;     // 最近一次出现的帧号
+    long long price;   // 拍卖价格（跨帧热启动）
+};
+vector<GoodRecord> good_records;     // 按货物ID索引
+vector<int> good_id_at;              // 格子 -> 该格当前货物的ID，-1表示没有
+vector<int> goods_alive;             // 当前在场的货物ID
+vector<int> goods_appeared;          // 本帧新出现的货物ID
+vector<int> goods_disappeared;       // 本帧消失（被取走或过期）的货物ID
+vector<int> goods_unchanged;         // 与上一帧相同的货物ID
+
+// 每帧读入数据后调用：为 goods_list 中的货物填上稳定ID，并生成本帧的差分事件
+void update_goods_registry() {
+    if ((int)good_id_at.size() != CELL_COUNT) good_id_at.assign(CELL_COUNT, -1);
+    goods_appeared.clear();
+    goods_disappeared.clear();
+    goods_unchanged.clear();
+    for (auto& g : goods_list) {
+        int c = g.x * N + g.y;
+        int id = good_id_at[c];
+        if (id != -1 && good_records[id].val == g.val && good_records[id].last_seen == frame_id - 1) {
+            goods_unchanged.push_back(id);
+        } else {
+            id = good_records.size();
+            good_records.push_back({c, g.val, frame_id, frame_id, 0});
+            good_id_at[c] = id;
+            goods_appeared.push_back(id);
         }
+        good_records[id].last_seen = frame_id;
+        g.id = id;
+    }
+    for (int id : goods_alive) {
+        if (good_records[id].last_seen == frame_id) continue;
+        goods_disappeared.push_back(id);
+        if (good_id_at[good_records[id].cell] == id) good_id_at[good_records[id].cell] = -1;
+    }
+    goods_alive = goods_unchanged;
+    goods_alive.insert(goods_alive.end(), goods_appeared.begin(), goods_appeared.end());
+}
+
+// 货物 id 在 arrive_frame 帧执行 get 时是否还在场
+inline bool good_alive_at(int id, int arrive_frame) {
+    return arrive_frame < good_records[id].first_seen + GOOD_LIFETIME;
+}
 
-        // ========== 货物的全局分配阶段 ==========
-        // 使用贪心算法为空闲的机器人分配货物
-        vector<int> robot_target_good(ROBOT_NUM, -1);  // 记录每个机器人的目标货物索引，-1表示无目标
-        vector<bool> good_assigned(goods_list.size(), false);  // 记录货物是否已被分配
-        vector<Candidate> candidates;  // 候选分配列表
+// ========== 货物距离场缓存 ==========
+// 货物会在地图上停留很多帧，因此为每个货物缓存一张“全图到该货物”的反向距离场：
+// 货物首次出现时用波前BFS计算，货物被取走/过期（登记表的消失事件）时释放；
+// 距离场只取决于坐标，同一格上旧货物消失、新货物出现时直接沿用；
+// 缓存槽数量有上限，超出时淘汰最久未使用（LRU）的距离场。
+// 取货导航变成在距离场上做梯度下降，评分也可以使用精确距离。
+// 计算受帧时间预算约束：新货物先进入待算队列，每帧只在预估耗时（最近几次计算的滑动平均）放得下时计算，
+// 其余留到之后的帧；导航需要的距离场放不下时同样推迟（插到队首），本帧改用地标下界贪心走一步。
+// 缓存槽数量按地图大小限制总内存：100x100 时为64个，大地图相应减少（至少4个）
+const int GOOD_FIELD_MAX = 64;
+const long long GOOD_FIELD_MEMORY = 256LL << 20;   // 距离场缓存的内存上限（字节）
+int GOOD_FIELD_BUDGET = GOOD_FIELD_MAX;            // 最多同时缓存的距离场数，load_map 时确定
 
-        // 为每个空闲且未携带货物的机器人计算所有货物的评分
-        for (int i = 0; i < ROBOT_NUM; i++) {
-            // 跳过不可用的机器人和已携带货物的机器人
-            if (robots[i].status == 0 || robots[i].has_goods) continue;
+struct GoodField {
+    int key = -1;          // 货物坐标 x*N+y，-1表示空槽
+    int last_used = 0;     // 最近一次使用的帧号，用于LRU淘汰
+    vector<int> dist;      // 全图每个点到该货物的真实距离，-1表示不可达
+};
+vector<GoodField> good_fields;
+vector<int> good_field_slot;         // 坐标 -> 缓存槽，-1表示未缓存
+deque<int> good_field_pending;       // 待计算距离场的货物坐标（导航急需的在队首）
 
-            // 计算该机器人到每个货物的评分
-            for (int j = 0; j < goods_list.size(); j++) {
-                // 计算曼哈顿距离（|x1-x2| + |y1-y2|）
-                int d = abs(robots[i].x - goods_list[j].x) + abs(robots[i].y - goods_list[j].y);
-                
-                // 获取货物到最近泊位的真实距离
-                int dist_to_berth = berth_dist[goods_list[j].x][goods_list[j].y];
-                if (dist_to_berth == -1) continue; // 无法到达泊位的货物忽略
+// 按地图大小确定缓存槽数量并分配索引表（load_map 之后调用一次）
+void init_good_fields() {
+    GOOD_FIELD_BUDGET = (int)max(4LL, min((long long)GOOD_FIELD_MAX, GOOD_FIELD_MEMORY / (4LL * CELL_COUNT)));
+    good_fields.assign(GOOD_FIELD_BUDGET, GoodField());
+    good_field_slot.assign(CELL_COUNT, -1);
+}
 
-                // 计算评分：货物价值 / (人货距离 + 货到泊位距离 + 1)
-                double score = (double)goods_list[j].val / (d + dist_to_berth + 1.0);
-                candidates.push_back({i, j, score});
-            }
+// 为坐标 key 的货物分配缓存槽并计算距离场；槽位已满时淘汰最久未使用的一个
+int build_good_field(int key) {
+    int slot = -1;
+    for (int s = 0; s < GOOD_FIELD_BUDGET; s++) {
+        if (good_fields[s].key == -1) { slot = s; break; }
+        if (slot == -1 || good_fields[s].last_used < good_fields[slot].last_used) slot = s;
+    }
+    GoodField& f = good_fields[slot];
+    if (f.key != -1) good_field_slot[f.key] = -1;
+    f.key = key;
+    f.last_used = frame_id;
+    f.dist.resize(CELL_COUNT);
+    auto t0 = chrono::steady_clock::now();
+    wavefront_field(vector<int>(1, key), f.dist.data());
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    good_field_cost_ms = good_field_cost_ms * 0.75 + ms * 0.25;
+    good_field_slot[key] = slot;
+    return slot;
+}
+
+// 每帧更新登记表后调用：释放已消失货物的距离场，把新出现的货物加入待算队列，
+// 并在不超过一半帧预算的前提下按队列顺序计算（货物已消失或已缓存的直接跳过）
+void update_good_fields() {
+    for (int id : goods_disappeared) {
+        int c = good_records[id].cell;
+        int slot = good_field_slot[c];
+        if (slot == -1 || good_id_at[c] != -1) continue;
+        good_field_slot[c] = -1;
+        good_fields[slot].key = -1;
+    }
+    for (int id : goods_appeared) good_field_pending.push_back(good_records[id].cell);
+    while (!good_field_pending.empty()) {
+        int c = good_field_pending.front();
+        if (good_id_at[c] == -1 || good_field_slot[c] != -1) {
+            good_field_pending.pop_front();
+            continue;
         }
-        
-        // 按评分降序排序（评分高的优先分配）
-        sort(candidates.begin(), candidates.end());
-        
-        // 贪心分配：按评分从高到低依次分配
-        // 确保每个机器人只分配一个货物，每个货物只分配给一个机器人
-        for (const auto& cand : candidates) {
-            if (robot_target_good[cand.robot_id] == -1 && !good_assigned[cand.good_idx]) {
-                robot_target_good[cand.robot_id] = cand.good_idx;
-                good_assigned[cand.good_idx] = true;
-            }
+        if (!frame_can_afford(good_field_cost_ms, 0.5)) break;
+        good_field_pending.pop_front();
+        build_good_field(c);
+    }
+}
+
+// 查询已缓存的货物距离场，未缓存返回 nullptr（评分阶段使用，不触发计算）
+const int* peek_good_field(int x, int y) {
+    int slot = good_field_slot[x * N + y];
+    if (slot == -1) return nullptr;
+    good_fields[slot].last_used = frame_id;
+    return good_fields[slot].dist.data();
+}
+
+// 获取货物距离场，若未缓存则在本帧预算放得下时计算（导航阶段使用）；放不下时插到待算队列队首并返回 nullptr
+const int* get_good_field(int x, int y) {
+    const int* f = peek_good_field(x, y);
+    if (f) return f;
+    if (!frame_can_afford(good_field_cost_ms)) {
+        good_field_pending.push_front(x * N + y);
+        return nullptr;
+    }
+    return good_fields[build_good_field(x * N + y)].dist.data();
+}
+
+// ========== 地标（ALT）距离下界 ==========
+// 启动时选取 LANDMARK_NUM 个地标（最远点采样：每次选离已有地标最远的可达格子），
+// 保存每个地标到全图的BFS距离（16位）。由三角不等式，任意两点 a、b 的真实距离满足
+//   dist(a,b) >= |d(L,a) - d(L,b)|，对所有地标取最大值即得到 O(K) 的紧下界；
+// 若某地标能到达其中一点却到不了另一点，则两点不连通。
+// 大地图上按上一个地标的实际耗时预估，启动预算放不下时少选几个（下界仍然成立，只是更松）。
+const int LANDMARK_NUM = 8;
+const unsigned short LANDMARK_INF = 0xFFFF;
+vector<vector<unsigned short>> landmark_dist;   // landmark_dist[k][x*N+y]
+
+void init_landmarks() {
+    landmark_dist.clear();
+    vector<int> field(CELL_COUNT);
+    vector<int> nearest(CELL_COUNT, -1);   // 每个格子到已选地标的最小距离，-1表示尚不可达
+    // 以泊位为种子（保证落在机器人真正活动的连通区域里，而不是孤立的小块空地），
+    // 先找到离它最远的格子作为第一个地标
+    int pick = berths.empty() ? -1 : berths[0].first * N + berths[0].second;
+    if (pick != -1) {
+        wavefront_field(vector<int>(1, pick), field.data());
+        for (int c = 0; c < CELL_COUNT; c++) if (field[c] > field[pick]) pick = c;
+    }
+    // 地标最多用到启动预算的 3/4，其余留给各泊位距离场
+    double cost_ms = 0;
+    while (pick != -1 && (int)landmark_dist.size() < LANDMARK_NUM && setup_can_afford(cost_ms, 0.75)) {
+        auto t0 = chrono::steady_clock::now();
+        wavefront_field(vector<int>(1, pick), field.data());
+        vector<unsigned short> table(CELL_COUNT, LANDMARK_INF);
+        for (int c = 0; c < CELL_COUNT; c++) {
+            if (field[c] < 0) continue;
+            table[c] = (unsigned short)min(field[c], (int)LANDMARK_INF - 1);
+            if (nearest[c] == -1 || field[c] < nearest[c]) nearest[c] = field[c];
+        }
+        landmark_dist.push_back(table);
+        // 下一个地标：离现有地标集合最远的格子
+        pick = -1;
+        for (int c = 0; c < CELL_COUNT; c++) {
+            if (nearest[c] > 0 && (pick == -1 || nearest[c] > nearest[pick])) pick = c;
+        }
+        cost_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    }
+}
+
+// 两点真实行走距离的下界（地标下界与曼哈顿距离取大），-1表示确定不连通
+int alt_distance(int ax, int ay, int bx, int by) {
+    int best = abs(ax - bx) + abs(ay - by);
+    int a = ax * N + ay, b = bx * N + by;
+    for (const auto& t : landmark_dist) {
+        unsigned short da = t[a], db = t[b];
+        if (da == LANDMARK_INF || db == LANDMARK_INF) {
+            if (da != db) return -1;
+            continue;
         }
+        int lb = da > db ? da - db : db - da;
+        if (lb > best) best = lb;
+    }
+    return best;
+}
 
-        // ========== 优先级计算与排序 ==========
-        // 根据货物价值分配优先级，携带货物的优先级最高
-        vector<int> robot_priority(ROBOT_NUM, 0);
-        vector<int> p_order(ROBOT_NUM);
-        for (int i = 0; i < ROBOT_NUM; i++) {
-            p_order[i] = i;
-            if (robots[i].has_goods) {
-                robot_priority[i] = 10000; // 携带货物的优先级最高
-            } else if (robot_target_good[i] != -1) {
-                robot_priority[i] = goods_list[robot_target_good[i]].val;
-            } else {
-                robot_priority[i] = 0;
+// 没有目标距离场时的后备一步：选地标下界 alt_distance 最小且未被占用的邻居（只取能缩短下界的方向）
+// 返回值：0-3为移动方向，-1表示没有这样的邻居
+int lower_bound_step(int x, int y, int tx, int ty) {
+    int best_dir = -1, best = alt_distance(x, y, tx, ty);
+    if (best <= 0) return -1;
+    const int* nb = &adj[4 * node_of[x * N + y]];
+    for (int i = 0; i < 4; i++) {
+        if (nb[i] == -1) continue;
+        int c = cell_of[nb[i]];
+        if (occupied_cell(c)) continue;
+        int d = alt_distance(c / N, c % N, tx, ty);
+        if (d >= 0 && d < best) {
+            best = d;
+            best_dir = i;
+        }
+    }
+    return best_dir;
+}
+
+// 连通块标记：对静态可走格子做泛洪填充，同一块内的格子编号相同
+// 机器人与货物不在同一连通块时一定走不到，评分和寻路前即可 O(1) 排除
+void label_components() {
+    comp_id.assign(CELL_COUNT, -1);
+    vector<int> stack;
+    int next_id = 0;
+    for (int v0 = 0; v0 < node_count; v0++) {
+        if (comp_id[cell_of[v0]] != -1) continue;
+        comp_id[cell_of[v0]] = next_id;
+        stack.push_back(v0);
+        while (!stack.empty()) {
+            int v = stack.back();
+            stack.pop_back();
+            for (int i = 0; i < 4; i++) {
+                int u = adj[4 * v + i];
+                if (u != -1 && comp_id[cell_of[u]] == -1) {
+                    comp_id[cell_of[u]] = next_id;
+                    stack.push_back(u);
+                }
             }
         }
-        // 按优先级降序排序，优先级高的机器人先行动
-        sort(p_order.begin(), p_order.end(), [&](int a, int b){
-            return robot_priority[a] > robot_priority[b];
-        });
+        next_id++;
+    }
+}
 
-        // ========== 机器人处理阶段 ==========
-        for (int k = 0; k < ROBOT_NUM; k++) {
-            int i = p_order[k]; // 按优先级顺序处理机器人
+// 命令行给出的规模参数，-1表示未指定（此时取地图头部的值，再没有则用默认值/按文件推断）
+int arg_rows = -1, arg_cols = -1, arg_robots = -1, arg_ships = -1;
 
-            // 跳过不可用的机器人
-            if (robots[i].status == 0) continue; 
+// 加载地图文件
+// 从 map_path（默认 maps/map1.txt）读取地图数据，确定地图与舰队规模，分配按尺寸的数组，并初始化泊位列表
+// 文件首行可以是头部 "行数 列数 [机器人数 船数]"（以数字开头，地图行只含 .*#AB 字符）
+// 文件打不开时报错后仍按命令行参数/默认尺寸分配全部数组（所有格子视为障碍），保证后续读帧不越界
+void load_map() {
+    ifstream in(map_path);
+    if (!in) cerr << "地图加载失败!" << endl;
+    vector<string> lines;
+    string line;
+    int head[4] = {-1, -1, -1, -1};
+    bool first = true;
+    while (getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (first && !line.empty() && isdigit((unsigned char)line[0])) {
+            istringstream hs(line);
+            for (int t = 0; t < 4 && (hs >> head[t]); t++) {}
+            first = false;
+            continue;
+        }
+        first = false;
+        if (!line.empty()) lines.push_back(line);
+    }
+    in.close();
 
-            // 更新卡死状态检测
-            // 如果机器人位置与上一帧相同，说明可能卡住了
-            if (robots[i].x == robots[i].last_x && robots[i].y == robots[i].last_y) {
-                robots[i].stuck_count++;  // 增加卡住计数
-            } else {
-                robots[i].stuck_count = 0;  // 重置卡住计数
-            }
-            // 更新上一帧位置
-            robots[i].last_x = robots[i].x;
-            robots[i].last_y = robots[i].y;
-
-            // 临时释放当前位置，用于路径规划
-            // 这样机器人可以规划从当前位置出发的路径
-            occupied[robots[i].x][robots[i].y] = false;
-
-            int move_dir = -1;  // 移动方向，-1表示不移动
-            bool action_taken = false;  // 是否执行了动作（get或pull）
-            int tx = -1, ty = -1; // 目标坐标，用于防卡死时的启发式选择
-
-            if (robots[i].has_goods) {
-                // ========== 携带货物状态：前往最近的泊位 ==========
-                int best_dist = 1e9;  // 最小距离初始化为很大值
-                int target_x = -1, target_y = -1;
-                
-                // 遍历所有泊位，找到距离当前机器人最近的泊位
-                for (auto& b : berths) {
-                    int d = abs(robots[i].x - b.first) + abs(robots[i].y - b.second);
-                    if (d < best_dist) {
-                        best_dist = d;
-                        target_x = b.first;
-                        target_y = b.second;
-                    }
-                }
+    MAP_ROWS = arg_rows > 0 ? arg_rows : head[0] > 0 ? head[0] : (lines.empty() ? 100 : (int)lines.size());
+    N = arg_cols > 0 ? arg_cols : head[1] > 0 ? head[1] : (lines.empty() ? 100 : (int)lines[0].size());
+    ROBOT_NUM = arg_robots > 0 ? arg_robots : head[2] > 0 ? head[2] : 10;
+    SHIP_NUM = arg_ships > 0 ? arg_ships : head[3] > 0 ? head[3] : 5;
+    CELL_COUNT = MAP_ROWS * N;
+    GRID_STRIDE = N + 2;
+    robots.assign(ROBOT_NUM, Robot());
+    ships.assign(SHIP_NUM, Ship());
 
-                if (target_x != -1) {
-                    tx = target_x; ty = target_y; // 记录目标
-                    // 如果已经在泊位位置，执行pull操作（将货物放到船上）
-                    if (robots[i].x == target_x && robots[i].y == target_y) {
-                        cout << "pull " << i << endl;
-                        action_taken = true;
-                    } else {
-                        // 否则使用BFS规划路径前往泊位
-                        move_dir = bfs(robots[i].x, robots[i].y, target_x, target_y);
-                    }
-                }
-            } else {
-                // ========== 未携带货物状态：前往预分配的目标货物 ==========
-                int target_idx = robot_target_good[i];
-                if (target_idx != -1) {
-                    tx = goods_list[target_idx].x; ty = goods_list[target_idx].y; // 记录目标
-                    // 如果已经在货物位置，执行get操作（捡起货物）
-                    if (robots[i].x == goods_list[target_idx].x && robots[i].y == goods_list[target_idx].y) {
-                        cout << "get " << i << endl;
-                        action_taken = true;
-                    } else {
-                        // 否则使用BFS规划路径前往货物
-                        move_dir = bfs(robots[i].x, robots[i].y, goods_list[target_idx].x, goods_list[target_idx].y);
-                    }
-                }
+    // 读取地图网格，写入带墙扁平网格（边框保持为墙）；缺失的格子按障碍处理
+    cell_flags.assign((MAP_ROWS + 2) * GRID_STRIDE, CELL_WALL);
+    berths.clear();
+    for (int i = 0; i < MAP_ROWS; i++) {
+        for (int j = 0; j < N; j++) {
+            char ch = (i < (int)lines.size() && j < (int)lines[i].size()) ? lines[i][j] : '#';
+            cell_flags[pad_of(i, j)] = (ch == '*' || ch == '#') ? CELL_WALL : 0;
+            // 如果该位置是泊位（标记为'B'），则记录其坐标
+            if (ch == 'B') {
+                berths.push_back({i, j});
             }
+        }
+    }
+    node_of.assign(CELL_COUNT, -1);
+    build_passable_bits();
+    build_graph();
+    label_components();
+}
 
-            // ========== 处理移动 ==========
-            if (!action_taken) {
-                int final_move_dir = -1;
+// ========== 共享内存传输 ==========
+// 命令行 --shm 名称 输入eventfd 输出eventfd（仅 Linux，判题器 --shm 时自动传入）：
+// 不再经过标准输入输出管道，而是在判题器创建的 POSIX 共享内存里用两个单生产者单消费者环形缓冲区交换消息，
+// 每条消息为 u32 长度 + 负载，负载就是原来管道上的字节流（文本或二进制协议都一样）。
+// 共享内存布局（与 judge.py 一致）：
+//   [0, 64)      u32 魔数 SHM_MAGIC、u32 每个环的容量
+//   [64, 320)    判题器→程序环的 head、tail，程序→判题器环的 head、tail，各为 u64 且各占一条缓存行
+//   [320, ...)   判题器→程序环的数据区，随后是程序→判题器环的数据区
+// head/tail 是累计写入/读出的字节数。写方写完数据再推进 head，然后向对方的 eventfd 写 1；
+// 读方在 eventfd 上阻塞等待，被唤醒后读出消息并推进 tail。eventfd 的读写是系统调用，兼作内存屏障。
+const unsigned SHM_MAGIC = 0x31524853;  // "SHR1"
+const int SHM_DATA_OFFSET = 320;
+bool io_shm = false;                   // 是否使用共享内存传输
+string shm_name;                       // 共享内存名称，命令行 --shm 设置
+int shm_in_fd = -1, shm_out_fd = -1;   // 判题器→程序、程序→判题器方向的 eventfd
+unsigned char* shm_base = nullptr;
+unsigned long long shm_cap = 0;        // 每个环的容量（字节）
+unsigned long long shm_msg_left = 0;   // 当前输入消息尚未取走的字节数
 
-                // 1. 尝试最优路径
-                if (move_dir != -1) {
-                    int nx = robots[i].x + dx[move_dir];
-                    int ny = robots[i].y + dy[move_dir];
-                    // 检查是否被占用
-                    if (!occupied[nx][ny]) {
-                        final_move_dir = move_dir;
-                    }
-                }
+// 小端序解码
+inline unsigned le_u16(const unsigned char* p) { return p[0] | (p[1] << 8); }
+inline unsigned le_u32(const unsigned char* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned)p[3] << 24); }
 
-                // 2. 防卡死机制：如果最优路径被阻挡 或 无路径，且已卡住一段时间
-                // 阈值设为2，意味着如果连续2帧没动，就开始尝试绕路
-                if (final_move_dir == -1 && robots[i].stuck_count > 2) {
-                    vector<int> alt_dirs;
-                    for (int d = 0; d < 4; d++) {
-                        if (d == move_dir) continue; // 跳过原本想走但走不通的方向
-                        
-                        int nx = robots[i].x + dx[d];
-                        int ny = robots[i].y + dy[d];
-                        
-                        // 检查合法性：边界、障碍物、是否被占用
-                        if (nx >= 0 && nx < N && ny >= 0 && ny < N && 
-                            grid[nx][ny] != '*' && grid[nx][ny] != '#' && !occupied[nx][ny]) {
-                            alt_dirs.push_back(d);
-                        }
-                    }
+#ifdef __linux__
+inline unsigned long long* shm_ctl(int slot) {
+    return reinterpret_cast<unsigned long long*>(shm_base + 64 + 64 * slot);
+}
 
-                    if (!alt_dirs.empty()) {
-                        // 如果有明确目标，按曼哈顿距离排序，优先选择离目标近的
-                        if (tx != -1) {
-                            sort(alt_dirs.begin(), alt_dirs.end(), [&](int a, int b){
-                                int da = abs(robots[i].x + dx[a] - tx) + abs(robots[i].y + dy[a] - ty);
-                                int db = abs(robots[i].x + dx[b] - tx) + abs(robots[i].y + dy[b] - ty);
-                                return da < db;
-                            });
-                        }
-                        final_move_dir = alt_dirs[0];
-                    }
-                }
+// 从环 ring（0 判题器→程序，1 程序→判题器）的位置 pos 开始读写 n 字节，处理回绕
+void shm_copy(int ring, unsigned long long pos, void* buf, size_t n, bool to_ring) {
+    unsigned char* data = shm_base + SHM_DATA_OFFSET + ring * shm_cap;
+    size_t off = pos % shm_cap;
+    size_t first = min(n, (size_t)(shm_cap - off));
+    unsigned char* b = static_cast<unsigned char*>(buf);
+    if (to_ring) {
+        memcpy(data + off, b, first);
+        memcpy(data, b + first, n - first);
+    } else {
+        memcpy(b, data + off, first);
+        memcpy(b + first, data, n - first);
+    }
+}
 
-                if (final_move_dir != -1) {
-                    cout << "move " << i << " " << final_move_dir << endl;
-                    int nx = robots[i].x + dx[final_move_dir];
-                    int ny = robots[i].y + dy[final_move_dir];
-                    occupied[nx][ny] = true;
-                } else {
-                    occupied[robots[i].x][robots[i].y] = true; // 保持原地
-                }
-            } else {
-                // 执行了get或pull动作，机器人保持原地不动
-                occupied[robots[i].x][robots[i].y] = true;
-            }
+// 打开判题器创建的共享内存
+bool shm_open_transport() {
+    int fd = shm_open(("/" + shm_name).c_str(), O_RDWR, 0);
+    if (fd == -1) return false;
+    struct stat st;
+    if (fstat(fd, &st) == -1 || st.st_size < SHM_DATA_OFFSET) {
+        close(fd);
+        return false;
+    }
+    void* p = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return false;
+    shm_base = static_cast<unsigned char*>(p);
+    const unsigned* head = reinterpret_cast<const unsigned*>(shm_base);
+    shm_cap = head[1];
+    if (head[0] != SHM_MAGIC || SHM_DATA_OFFSET + 2 * shm_cap > (unsigned long long)st.st_size) return false;
+    return true;
+}
+
+// 从判题器→程序环读出至多 cap 字节（当前消息读完后阻塞等待下一条），判题器结束时返回 0
+int shm_read(char* buf, int cap) {
+    unsigned long long* head = shm_ctl(0);
+    unsigned long long* tail = shm_ctl(1);
+    while (shm_msg_left == 0) {
+        while (__atomic_load_n(head, __ATOMIC_ACQUIRE) == *tail) {
+            uint64_t cnt;
+            if (read(shm_in_fd, &cnt, sizeof(cnt)) != sizeof(cnt)) return 0;
         }
+        unsigned char len[4];
+        shm_copy(0, *tail, len, 4, false);
+        __atomic_store_n(tail, *tail + 4, __ATOMIC_RELEASE);
+        shm_msg_left = le_u32(len);
+    }
+    size_t n = min((unsigned long long)cap, shm_msg_left);
+    shm_copy(0, *tail, buf, n, false);
+    __atomic_store_n(tail, *tail + n, __ATOMIC_RELEASE);
+    shm_msg_left -= n;
+    return (int)n;
+}
+
+// 把 n 字节作为一条消息写入程序→判题器环并通知判题器
+bool shm_write(const char* p, size_t n) {
+    unsigned long long* head = shm_ctl(2);
+    unsigned long long* tail = shm_ctl(3);
+    if (4 + n > shm_cap - (*head - __atomic_load_n(tail, __ATOMIC_ACQUIRE))) return false;
+    unsigned char len[4] = {(unsigned char)(n & 0xFF), (unsigned char)((n >> 8) & 0xFF),
+                            (unsigned char)((n >> 16) & 0xFF), (unsigned char)(n >> 24)};
+    shm_copy(1, *head, len, 4, true);
+    shm_copy(1, *head + 4, const_cast<char*>(p), n, true);
+    __atomic_store_n(head, *head + 4 + n, __ATOMIC_RELEASE);
+    uint64_t one = 1;
+    return write(shm_out_fd, &one, sizeof(one)) == sizeof(one);
+}
+#else
+bool shm_open_transport() { return false; }
+int shm_read(char*, int) { return 0; }
+bool shm_write(const char*, size_t) { return false; }
+#endif
 
-        // ========== 船只处理阶段 ==========
-        // 简单策略：让所有船只都执行go命令（离开泊位）
-        for (int i = 0; i < SHIP_NUM; i++) {
-            cout << "go " << i << endl;
+// ========== 帧输入输出 ==========
+// 输入：用 read() 一次读入一大块到可复用的缓冲区，直接在缓冲区里解析整数，不再逐个经过 cin。
+// 输出：本帧所有指令先拼进 out_buf，到 OK 时用一次 write() 整块写出，避免每行 endl 都刷新一次管道。
+// 命令行 --iostream 改回 cin/cout（调试用），此时同样在 OK 时才刷新。
+//
+// 二进制协议（判题器 --binary 时协商启用，默认仍为文本协议）：
+//   判题器先发送 4 字节魔数 "PBN1"，程序在读第一帧前看到它就回复同样的 4 字节表示接受，之后双方改用二进制。
+//   每帧输入：u32 长度 + 记录体，记录体为 i32 帧号、i32 金钱、u32 货物数，
+//            每个货物 u16 x、u16 y、u16 价值，每个机器人 u16 x、u16 y、u8 是否带货、u8 状态，
+//            每艘船 i16 状态、i16 泊位ID。
+//   每帧输出：u32 长度 + 若干 4 字节指令，每条为 u8 操作码（CmdOp）、u8 参数（move 的方向）、u16 编号；
+//            长度前缀代替文本协议的 OK。
+//   所有多字节整数均为小端序。
+//
+// 增量帧（判题器 --delta 时启用，两种协议都支持，程序按帧首自动识别，无需协商）：
+//   只发送相对上一帧的变化：新增货物、消失货物（按坐标）、状态有变化的机器人和船；
+//   判题器每 DELTA_KEYFRAME 帧（及第 1 帧）仍发送完整的关键帧，程序收到关键帧即整体重置，用于从失步中恢复。
+//   文本格式："D <帧号> <金钱>"，随后依次为 消失数 + 各行 "x y"、新增数 + 各行 "x y 价值"、
+//            变化机器人数 + 各行 "编号 是否带货 x y 状态"、变化船数 + 各行 "编号 状态 泊位ID"，最后 OK。
+//   二进制格式：长度前缀最高位置 1，记录体为 i32 帧号、i32 金钱、u32 消失数 + 各 u16 x/y、
+//            u32 新增数 + 各 u16 x/y/价值、u32 变化机器人数 + 各 u16 编号/x/y + u8 带货/状态、
+//            u32 变化船数 + 各 u16 编号 + i16 状态/泊位ID。
+//   新增货物追加到 goods_list 末尾、消失货物按原顺序删除，与判题器按插入顺序列出货物一致，
+//   因此增量帧与完整帧得到的 goods_list 完全相同。
+bool io_iostream = false;       // 命令行 --iostream 设置
+bool io_binary = false;         // 是否已协商为二进制协议
+const char BINARY_MAGIC[4] = {'P', 'B', 'N', '1'};
+const int IN_BUF_SIZE = 1 << 16;
+vector<char> in_buf(IN_BUF_SIZE);
+int in_pos = 0, in_len = 0;     // 缓冲区中未解析数据为 in_buf[in_pos .. in_len)
+string out_buf;                 // 本帧待输出的指令
+vector<unsigned char> frame_rec; // 二进制协议下本帧的记录体
+
+// 指令操作码（同时是二进制协议中的编码）
+enum CmdOp { CMD_MOVE = 1, CMD_GET = 2, CMD_PULL = 3, CMD_GO = 4 };
+const char* const CMD_NAMES[] = {"", "move", "get", "pull", "go"};
+
+// 进程内驱动（模拟器）时不编码输出，指令按顺序记录在 frame_cmds 中
+struct FrameCommand {
+    int op, id, arg;
+};
+bool io_capture = false;
+vector<FrameCommand> frame_cmds;
+
+// 从标准输入或共享内存读入至多 cap 字节，输入结束返回 0 或负数
+inline int io_read_chunk(char* buf, int cap) {
+    return io_shm ? shm_read(buf, cap) : (int)IO_READ(0, buf, cap);
+}
+
+// 取下一个字节（缓冲区耗尽时再读一块），输入结束返回 -1
+inline int in_getc() {
+    if (io_iostream) return cin.get();
+    if (in_pos == in_len) {
+        int n = io_read_chunk(in_buf.data(), IN_BUF_SIZE);
+        if (n <= 0) return -1;
+        in_pos = 0;
+        in_len = n;
+    }
+    return (unsigned char)in_buf[in_pos++];
+}
+
+// 读 n 个字节到 dst，输入提前结束返回 false
+bool in_bytes(void* dst, size_t n) {
+    char* p = static_cast<char*>(dst);
+    if (io_iostream) return (bool)cin.read(p, n);
+    while (n > 0) {
+        if (in_pos == in_len) {
+            int r = io_read_chunk(in_buf.data(), IN_BUF_SIZE);
+            if (r <= 0) return false;
+            in_pos = 0;
+            in_len = r;
         }
+        size_t take = min(n, (size_t)(in_len - in_pos));
+        memcpy(p, in_buf.data() + in_pos, take);
+        in_pos += take;
+        p += take;
+        n -= take;
+    }
+    return true;
+}
+
+// 读一个整数，跳过前面的空白；输入结束返回 false
+bool in_int(int& v) {
+    if (io_iostream) return (bool)(cin >> v);
+    int c = in_getc();
+    while (c != -1 && c != '-' && (c < '0' || c > '9')) c = in_getc();
+    if (c == -1) return false;
+    bool neg = c == '-';
+    if (neg) c = in_getc();
+    v = 0;
+    while (c >= '0' && c <= '9') {
+        v = v * 10 + (c - '0');
+        c = in_getc();
+    }
+    if (neg) v = -v;
+    return true;
+}
 
+// 跳过空白并查看下一个字符（不取走），输入结束返回 -1
+int in_peek() {
+    if (io_iostream) {
+        cin >> ws;
+        return cin.peek();
+    }
+    int c = in_getc();
+    while (c != -1 && isspace(c)) c = in_getc();
+    if (c != -1) in_pos--;  // 刚从缓冲区取出，直接放回
+    return c;
+}
+
+// 跳过一个单词（帧末的 "OK"）
+void in_skip_word() {
+    if (io_iostream) {
+        string s;
+        cin >> s;
+        return;
+    }
+    int c = in_getc();
+    while (c != -1 && isspace(c)) c = in_getc();
+    while (c != -1 && !isspace(c)) c = in_getc();
+}
+
+// 追加一条指令（arg 为 -1 时省略，只有 move 带方向）
+void out_cmd(CmdOp op, int id, int arg = -1) {
+    if (io_capture) {
+        frame_cmds.push_back({op, id, arg});
+        return;
+    }
+    if (io_binary) {
+        char rec[4] = {(char)op, (char)(arg == -1 ? 0 : arg), (char)(id & 0xFF), (char)((id >> 8) & 0xFF)};
+        out_buf.append(rec, 4);
+        return;
+    }
+    char line[48];
+    int n = arg == -1 ? snprintf(line, sizeof(line), "%s %d\n", CMD_NAMES[op], id)
+                      : snprintf(line, sizeof(line), "%s %d %d\n", CMD_NAMES[op], id, arg);
+    out_buf.append(line, n);
+}
+
+// 把 out_buf 一次写出并清空
+void out_write() {
+    if (io_shm) {
+        if (!shm_write(out_buf.data(), out_buf.size())) cerr << "共享内存写入失败" << endl;
+    } else if (io_iostream) {
+        cout.write(out_buf.data(), out_buf.size());
+        cout.flush();
+    } else {
+        const char* p = out_buf.data();
+        size_t left = out_buf.size();
+        while (left > 0) {
+            int n = (int)IO_WRITE(1, p, (unsigned)left);
+            if (n <= 0) break;
+            p += n;
+            left -= n;
+        }
+    }
+    out_buf.clear();
+}
+
+// 结束本帧输出：文本协议追加 OK，二进制协议在前面补上长度
+void out_flush_frame() {
+    if (io_binary) {
+        unsigned len = out_buf.size();
+        char head[4] = {(char)(len & 0xFF), (char)((len >> 8) & 0xFF), (char)((len >> 16) & 0xFF), (char)(len >> 24)};
+        out_buf.insert(0, head, 4);
+    } else {
+        out_buf += "OK\n";
+    }
+    out_write();
+}
+
+// 读第一帧前调用：输入以魔数开头时切换到二进制协议并回复确认
+void negotiate_protocol() {
+    int c = io_iostream ? cin.peek() : in_getc();
+    if (c == -1) return;
+    if (!io_iostream) in_pos--;  // 放回缓冲区
+    if (c != BINARY_MAGIC[0]) return;
+    char magic[4];
+    if (!in_bytes(magic, 4) || memcmp(magic, BINARY_MAGIC, 4) != 0) {
+        cerr << "无法识别的协议头" << endl;
+        return;
+    }
+    io_binary = true;
+    out_buf.assign(BINARY_MAGIC, 4);
+    out_write();
+}
+
+// ========== 增量帧 ==========
+vector<char> delta_removed;     // 本帧增量中标记为消失的格子（x*N+y）
+vector<int> delta_removed_list; // 同上，列表形式，用于清除标记
+
+// 增量帧：标记格子 (x, y) 上的货物消失，apply_removed_goods 时统一删除
+void delta_remove_good(int x, int y) {
+    if ((int)delta_removed.size() != CELL_COUNT) delta_removed.assign(CELL_COUNT, 0);
+    int c = x * N + y;
+    if (!delta_removed[c]) {
+        delta_removed[c] = 1;
+        delta_removed_list.push_back(c);
+    }
+}
+
+// 按原顺序删除被标记的货物并清除标记；必须在追加新增货物之前调用
+void apply_removed_goods() {
+    if (delta_removed_list.empty()) return;
+    goods_list.erase(remove_if(goods_list.begin(), goods_list.end(), [](const Goods& g) {
+        return delta_removed[g.x * N + g.y] != 0;
+    }), goods_list.end());
+    for (int c : delta_removed_list) delta_removed[c] = 0;
+    delta_removed_list.clear();
+}
+
+// 增量帧：在末尾追加一个新出现的货物
+void delta_add_good(int x, int y, int val) {
+    Goods g;
+    g.x = x;
+    g.y = y;
+    g.val = val;
+    g.comp = comp_id[x * N + y];
+    g.id = -1;
+    goods_list.push_back(g);
+}
+
+// 读取一个文本增量帧（开头的 'D' 尚未取走）
+bool read_delta_text() {
+    in_skip_word(); // 跳过 "D"
+    if (!in_int(frame_id) || !in_int(money)) return false;
+    int k, x, y, v;
+    in_int(k);
+    for (int t = 0; t < k; t++) {
+        in_int(x);
+        in_int(y);
+        delta_remove_good(x, y);
+    }
+    apply_removed_goods();
+    in_int(k);
+    for (int t = 0; t < k; t++) {
+        in_int(x);
+        in_int(y);
+        in_int(v);
+        delta_add_good(x, y, v);
+    }
+    in_int(k);
+    for (int t = 0; t < k; t++) {
+        int i, has_goods, rx, ry, status;
+        in_int(i);
+        in_int(has_goods);
+        in_int(rx);
+        in_int(ry);
+        in_int(status);
+        if (i < 0 || i >= ROBOT_NUM) continue;
+        robots[i].has_goods = has_goods;
+        robots[i].x = rx;
+        robots[i].y = ry;
+        robots[i].status = status;
+        robots[i].comp = comp_id[rx * N + ry];
+    }
+    in_int(k);
+    for (int t = 0; t < k; t++) {
+        int i, status, berth_id;
+        in_int(i);
+        in_int(status);
+        in_int(berth_id);
+        if (i < 0 || i >= SHIP_NUM) continue;
+        ships[i].status = status;
+        ships[i].berth_id = berth_id;
+    }
+    in_skip_word(); // 跳过 "OK"
+    return true;
+}
+
+// 解码二进制增量帧的记录体 frame_rec
+bool read_delta_binary() {
+    const unsigned char* p = frame_rec.data();
+    const unsigned char* end = p + frame_rec.size();
+    auto has = [&](size_t n) { return (size_t)(end - p) >= n; };
+    if (!has(12)) return false;
+    frame_id = (int)le_u32(p);
+    money = (int)le_u32(p + 4);
+    unsigned k = le_u32(p + 8);
+    p += 12;
+    if (!has((size_t)k * 4 + 4)) return false;
+    for (unsigned t = 0; t < k; t++, p += 4) delta_remove_good(le_u16(p), le_u16(p + 2));
+    apply_removed_goods();
+    k = le_u32(p);
+    p += 4;
+    if (!has((size_t)k * 6 + 4)) return false;
+    for (unsigned t = 0; t < k; t++, p += 6) delta_add_good(le_u16(p), le_u16(p + 2), le_u16(p + 4));
+    k = le_u32(p);
+    p += 4;
+    if (!has((size_t)k * 8 + 4)) return false;
+    for (unsigned t = 0; t < k; t++, p += 8) {
+        int i = le_u16(p);
+        if (i >= ROBOT_NUM) continue;
+        robots[i].x = le_u16(p + 2);
+        robots[i].y = le_u16(p + 4);
+        robots[i].has_goods = p[6];
+        robots[i].status = p[7];
+        robots[i].comp = comp_id[robots[i].x * N + robots[i].y];
+    }
+    k = le_u32(p);
+    p += 4;
+    if (!has((size_t)k * 6)) return false;
+    for (unsigned t = 0; t < k; t++, p += 6) {
+        int i = le_u16(p);
+        if (i >= SHIP_NUM) continue;
+        ships[i].status = (short)le_u16(p + 2);
+        ships[i].berth_id = (short)le_u16(p + 4);
+    }
+    return true;
+}
+
+// 二进制协议下读取一帧：先读长度前缀，再整块读入记录体后解码（最高位为 1 时是增量帧）
+bool read_frame_binary() {
+    unsigned char head[4];
+    if (!in_bytes(head, 4)) return false;
+    unsigned len = le_u32(head);
+    frame_rec.resize(len & 0x7FFFFFFFu);
+    if (!in_bytes(frame_rec.data(), frame_rec.size())) return false;
+    if (len & 0x80000000u) return read_delta_binary();
+    size_t need = 12 + (size_t)ROBOT_NUM * 6 + (size_t)SHIP_NUM * 4;
+    const unsigned char* p = frame_rec.data();
+    if (frame_rec.size() < need) return false;
+    frame_id = (int)le_u32(p);
+    money = (int)le_u32(p + 4);
+    int k = (int)le_u32(p + 8);
+    if (frame_rec.size() != need + (size_t)k * 6) return false;
+    p += 12;
+    goods_list.resize(k);
+    for (int i = 0; i < k; i++, p += 6) {
+        goods_list[i].x = le_u16(p);
+        goods_list[i].y = le_u16(p + 2);
+        goods_list[i].val = le_u16(p + 4);
+        goods_list[i].comp = comp_id[goods_list[i].x * N + goods_list[i].y];
+    }
+    for (int i = 0; i < ROBOT_NUM; i++, p += 6) {
+        robots[i].x = le_u16(p);
+        robots[i].y = le_u16(p + 2);
+        robots[i].has_goods = p[4];
+        robots[i].status = p[5];
+        robots[i].comp = comp_id[robots[i].x * N + robots[i].y];
+    }
+    for (int i = 0; i < SHIP_NUM; i++, p += 4) {
+        ships[i].status = (short)le_u16(p);
+        ships[i].berth_id = (short)le_u16(p + 2);
+    }
+    return true;
+}
+
+// 读取每一帧的数据
+// 从标准输入读取当前帧的游戏状态数据
+// 返回值：成功读取返回true，读取失败（游戏结束）返回false
+bool read_frame_data() {
+    if (io_binary) return read_frame_binary();
+    if (in_peek() == 'D') return read_delta_text();
+    // 读取帧ID和当前金钱
+    if (!in_int(frame_id) || !in_int(money)) return false;
+    
+    int k;
+    in_int(k);  // 读取当前帧的货物数量
+    // 读取所有货物的信息（坐标和价值）
+    goods_list.resize(k);
+    for (int i = 0; i < k; i++) {
+        in_int(goods_list[i].x);
+        in_int(goods_list[i].y);
+        in_int(goods_list[i].val);
+        goods_list[i].comp = comp_id[goods_list[i].x * N + goods_list[i].y];
+    }
+    
+    // 读取所有机器人的状态信息
+    for (int i = 0; i < ROBOT_NUM; i++) {
+        in_int(robots[i].has_goods);
+        in_int(robots[i].x);
+        in_int(robots[i].y);
+        in_int(robots[i].status);
+        robots[i].comp = comp_id[robots[i].x * N + robots[i].y];
+    }
+    
+    // 读取所有船只的状态信息
+    for (int i = 0; i < SHIP_NUM; i++) {
+        in_int(ships[i].status);
+        in_int(ships[i].berth_id);
+    }
+    
+    in_skip_word(); // 跳过 "OK" 确认标志，表示帧数据读取完成
+    return true;
+}
+
+// 寻路工作区：所有逐次搜索共用的扁平数组，按结点编号（见“压缩可走图”）索引，建图后一次性分配
+// 访问标记采用“代数戳”：stamp[v]==epoch 表示本次搜索已访问该结点，
+// 开始新的搜索只需 epoch++，不必清空数组；队列是容量为2的幂的环形缓冲区，存32位结点编号。
+typedef unsigned int NodeId;        // 结点编号（大地图的格子数超过16位范围）
+
+struct SearchWorkspace {
+    vector<unsigned int> stamp;     // 访问代数戳
+    unsigned int epoch = 0;         // 当前搜索的代数
+    vector<signed char> from_dir;   // 到达该结点时走的方向，用于回溯路径
+    vector<NodeId> queue;           // 环形队列，容量 queue_mask+1 不小于结点数
+    unsigned int queue_mask = 0;
+    unsigned int head = 0, tail = 0;
+
+    // A* 使用的额外状态：g 值、关闭标记（同样用代数戳）和定长二叉堆
+    // 堆元素为 (键, 结点编号)，键把 (f, -g) 打包成一个64位整数，f 相同时优先扩展 g 更大（更深）的结点
+    vector<int> g;
+    vector<int> parent;              // 父结点编号（JPS 中跳点之间不相邻，需要显式记录）
+    vector<unsigned int> closed;
+    vector<pair<unsigned long long, NodeId>> heap;  // 按需增长（每个结点最多因四个邻居各入堆一次）
+    int heap_size = 0;
+
+    // 按结点数分配全部数组
+    void init(int nodes) {
+        unsigned int cap = 1;
+        while (cap < (unsigned int)max(nodes, 1)) cap <<= 1;
+        stamp.assign(nodes, 0);
+        closed.assign(nodes, 0);
+        from_dir.assign(nodes, -1);
+        g.assign(nodes, 0);
+        parent.assign(nodes, -1);
+        queue.assign(cap, 0);
+        queue_mask = cap - 1;
+        heap.clear();
+        heap.reserve(min(4 * (size_t)nodes + 1, (size_t)1 << 16));
+        epoch = 0;
+    }
+
+    // 开始一次新的搜索：代数加一，队列清空；代数溢出回绕时才真正清空一次标记
+    void begin() {
+        if (++epoch == 0) {
+            fill(stamp.begin(), stamp.end(), 0);
+            fill(closed.begin(), closed.end(), 0);
+            epoch = 1;
+        }
+        head = tail = 0;
+        heap_size = 0;
+    }
+    bool visited(int v) const { return stamp[v] == epoch; }
+    void visit(int v, int dir) { stamp[v] = epoch; from_dir[v] = dir; }
+    void push(int v) { queue[tail++ & queue_mask] = (NodeId)v; }
+    int pop() { return queue[head++ & queue_mask]; }
+    bool empty() const { return head == tail; }
+
+    bool is_closed(int v) const { return closed[v] == epoch; }
+    void close(int v) { closed[v] = epoch; }
+    void heap_push(int f, int gv, int v) {
+        if (heap_size == (int)heap.size()) heap.emplace_back();
+        heap[heap_size++] = make_pair(((unsigned long long)f << 32) | (0xFFFFFFFFu - (unsigned int)gv), (NodeId)v);
+        push_heap(heap.begin(), heap.begin() + heap_size, greater<pair<unsigned long long, NodeId>>());
+    }
+    int heap_pop() {
+        pop_heap(heap.begin(), heap.begin() + heap_size, greater<pair<unsigned long long, NodeId>>());
+        return (int)heap[--heap_size].second;
+    }
+};
+SearchWorkspace search_ws;
+
+// 结点 v 当前是否可进入：不是哨兵且未被其他机器人占用
+inline bool node_free(int v) {
+    return v != -1 && !node_occupied(v);
+}
+
+// 从 search_ws.from_dir 回溯出起点出发的第一步方向（bfs 与 astar 共用），参数为结点编号
+// from_dir[v] 是从父结点走到 v 的方向，因此父结点为 v 在反方向（d^1）上的邻居
+int first_step(int start, int target) {
+    int v = target;
+    while (true) {
+        int d = search_ws.from_dir[v];
+        int p = adj[4 * v + (d ^ 1)];
+        if (p == start) return d;
+        v = p;
+    }
+}
+
+// 使用BFS（广度优先搜索）算法寻找从起点到目标位置的下一步移动方向
+// 搜索在压缩可走图上进行，状态全部放在全局工作区 search_ws 中，稳态下不做任何堆分配
+// 参数：
+//   start_x, start_y: 起点坐标
+//   target_x, target_y: 目标坐标
+// 返回值：
+//   0-3: 表示移动方向（右、左、上、下）
+//   -1: 表示已在目标位置或无法到达目标
+int bfs(int start_x, int start_y, int target_x, int target_y) {
+    // 如果已经在目标位置，返回-1
+    if (start_x == target_x && start_y == target_y) return -1;
+
+    int start = node_of[start_x * N + start_y];
+    int target = node_of[target_x * N + target_y];
+    if (start == -1 || target == -1) return -1;
+
+    search_ws.begin();
+    search_ws.visit(start, -1);
+    search_ws.push(start);
+
+    bool found = false;
+    // BFS搜索主循环
+    while (!search_ws.empty()) {
+        int curr = search_ws.pop();
+
+        // 找到目标位置
+        if (curr == target) {
+            found = true;
+            break;
+        }
+
+        // 尝试向四个方向移动：邻接表已排除越界和障碍，只需检查访问标记和动态占用
+        const int* nb = &adj[4 * curr];
+        for (int i = 0; i < 4; i++) {
+            int v = nb[i];
+            if (v != -1 && !search_ws.visited(v) && !node_occupied(v)) {
+                search_ws.visit(v, i);
+                search_ws.push(v);
+            }
+        }
+    }
+
+    // 如果未找到路径，返回-1
+    if (!found) return -1;
+
+    // 从目标位置沿 from_dir 回溯到起点，得到起点出发的第一步
+    return first_step(start, target);
+}
+
+// A* 寻路：返回值约定与 bfs() 相同（0-3为方向，-1为已到达或不可达）
+// h_field 为启发函数表（按格子编号 x*N+y 索引，-1表示不可达）：
+//   运货阶段传入目标泊位的距离场 berth_each_dist[b]，它是忽略机器人占用时的精确距离，
+//   占用只会让路变长，因此仍是可采纳且一致的启发；
+//   传入 nullptr 时使用地标下界 alt_distance()（不小于曼哈顿距离）。
+int astar(int start_x, int start_y, int target_x, int target_y, const int* h_field) {
+    if (start_x == target_x && start_y == target_y) return -1;
+
+    int start = node_of[start_x * N + start_y];
+    int target = node_of[target_x * N + target_y];
+    if (start == -1 || target == -1) return -1;
+
+    search_ws.begin();
+    search_ws.visit(start, -1);
+    search_ws.g[start] = 0;
+    int h0 = h_field ? h_field[cell_of[start]] : alt_distance(start_x, start_y, target_x, target_y);
+    if (h0 < 0) return -1;
+    search_ws.heap_push(h0, 0, start);
+
+    while (search_ws.heap_size > 0) {
+        int curr = search_ws.heap_pop();
+        if (search_ws.is_closed(curr)) continue;  // 堆中的过期条目
+        if (curr == target) return first_step(start, target);
+        search_ws.close(curr);
+
+        int cg = search_ws.g[curr];
+        const int* nb = &adj[4 * curr];
+        for (int i = 0; i < 4; i++) {
+            int v = nb[i];
+            if (v == -1 || search_ws.is_closed(v) || node_occupied(v)) continue;
+            if (search_ws.visited(v) && search_ws.g[v] <= cg + 1) continue;
+            int h = h_field ? h_field[cell_of[v]] : alt_distance(node_x[v], node_y[v], target_x, target_y);
+            if (h < 0) continue;
+            search_ws.visit(v, i);
+            search_ws.g[v] = cg + 1;
+            search_ws.heap_push(cg + 1 + h, cg + 1, v);
+        }
+    }
+    return -1;
+}
+
+// JPS 水平跳跃：从结点 v 沿方向 d（0/1，即列方向）一直走，返回遇到的跳点结点，撞墙返回-1
+// 跳点条件：到达目标，或出现“强迫邻居”——上/下方当前可走而上一格的上/下方被挡住
+int jps_jump_row(int v, int d, int target) {
+    while (true) {
+        int prev = v;
+        v = adj[4 * v + d];
+        if (!node_free(v)) return -1;
+        if (v == target) return v;
+        for (int p = 2; p < 4; p++) {
+            if (node_free(adj[4 * v + p]) && !node_free(adj[4 * prev + p])) return v;
+        }
+    }
+}
+
+// JPS 竖直跳跃：从结点 v 沿方向 d（2/3，即行方向）一直走
+// 四连通网格上只有竖直方向的跳跃会向两侧探测水平跳点，水平跳跃只需检查强迫邻居
+int jps_jump_col(int v, int d, int target) {
+    while (true) {
+        int prev = v;
+        v = adj[4 * v + d];
+        if (!node_free(v)) return -1;
+        if (v == target) return v;
+        for (int p = 0; p < 2; p++) {
+            if (node_free(adj[4 * v + p]) && !node_free(adj[4 * prev + p])) return v;
+        }
+        if (jps_jump_row(v, 0, target) != -1 || jps_jump_row(v, 1, target) != -1) return v;
+    }
+}
+
+// 跳点搜索（Jump Point Search，四连通版本）
+// 在开阔的均匀代价网格上跳过对称路径，只把跳点放入开放列表；
+// 可走性与 bfs() 相同（含 occupied 动态占用），返回值约定也与 bfs() 相同。
+// 直线跳跃沿邻接表进行，强迫邻居通过当前结点与上一结点的侧向邻居判断。
+int jps(int start_x, int start_y, int target_x, int target_y) {
+    if (start_x == target_x && start_y == target_y) return -1;
+
+    int start = node_of[start_x * N + start_y];
+    int target = node_of[target_x * N + target_y];
+    if (start == -1 || target == -1) return -1;
+
+    search_ws.begin();
+    search_ws.visit(start, -1);
+    search_ws.g[start] = 0;
+    search_ws.parent[start] = -1;
+    search_ws.heap_push(abs(start_x - target_x) + abs(start_y - target_y), 0, start);
+
+    while (search_ws.heap_size > 0) {
+        int curr = search_ws.heap_pop();
+        if (search_ws.is_closed(curr)) continue;
+        if (curr == target) {
+            // 沿跳点父链回溯到起点之后的第一个跳点，跳点之间是直线段，其到达方向即第一步方向
+            while (search_ws.parent[curr] != start) curr = search_ws.parent[curr];
+            return search_ws.from_dir[curr];
+        }
+        search_ws.close(curr);
+
+        int cx = node_x[curr];
+        int cy = node_y[curr];
+        int cg = search_ws.g[curr];
+        int came = search_ws.from_dir[curr];
+        for (int i = 0; i < 4; i++) {
+            // 邻居剪枝：沿列方向到达的结点只向前和上下扩展，沿行方向到达的只向前和左右扩展
+            if (came != -1 && i == (came ^ 1)) continue;
+            int jp = (i < 2) ? jps_jump_row(curr, i, target) : jps_jump_col(curr, i, target);
+            if (jp == -1 || search_ws.is_closed(jp)) continue;
+            int jx = node_x[jp], jy = node_y[jp];
+            int ng = cg + abs(jx - cx) + abs(jy - cy);
+            if (search_ws.visited(jp) && search_ws.g[jp] <= ng) continue;
+            search_ws.visit(jp, i);
+            search_ws.g[jp] = ng;
+            search_ws.parent[jp] = curr;
+            search_ws.heap_push(ng + abs(jx - target_x) + abs(jy - target_y), ng, jp);
+        }
+    }
+    return -1;
+}
+
+// ========== 分层寻路（HPA*） ==========
+// 把地图切成 HPA_C x HPA_C 的簇，在相邻簇的公共边界上找出连续可走段，每段放置入口（两侧各一个格子）；
+// 入口格子是抽象图的结点，簇内结点之间用簇内BFS距离连边，跨边界的入口对之间连长度为1的边。
+// 寻路时先在抽象图上规划，再只把第一段（起点所在簇内部）细化成真实路径，得到第一步方向。
+// 抽象图只依赖静态地形；起点簇内的细化搜索考虑 occupied 动态占用。
+// 地形变化时调用 hpa_refresh_cluster() 只重建受影响的簇，无需全图重建。
+const int HPA_C = 10;                          // 簇边长
+int HPA_KR = 0, HPA_KC = 0;                    // 簇的行数、列数（init_hpa 时按地图尺寸确定）
+int HPA_KN = 0;                                // 簇总数，簇编号 = 簇行*HPA_KC + 簇列
+const int HPA_LONG_ENTRANCE = 6;               // 可走段长度不小于该值时在两端各放一个入口，否则放在中点
+
+struct HpaCluster {
+    vector<int> cells;               // 簇内抽象结点（入口格子编号）
+    vector<vector<int>> partners;    // 每个结点跨边界相连的格子
+    vector<int> dist;                // 簇内两两距离，cells.size()^2，-1表示簇内不可达
+};
+vector<HpaCluster> hpa_clusters;
+vector<vector<pair<int, int>>> hpa_border[2];  // [0]：与右侧簇的边界，[1]：与下方簇的边界；元素为(本簇格子, 邻簇格子)
+vector<int> hpa_node_local;                    // 格子 -> 在所属簇 cells 中的下标，-1表示不是抽象结点
+vector<int> hpa_offset;                        // 抽象结点全局编号 = hpa_offset[簇] + 簇内下标，共 HPA_KN+1 项
+
+// 抽象层搜索用的状态（按全局结点编号索引，最后一个编号是虚拟的终点结点）
+vector<int> hpa_g, hpa_first, hpa_dt;
+vector<unsigned int> hpa_stamp;
+vector<unsigned long long> hpa_heap;
+unsigned int hpa_epoch = 0;
+
+inline int hpa_cluster_of(int cell) {
+    return (cell / N / HPA_C) * HPA_KC + (cell % N) / HPA_C;
+}
+
+// 重建簇 k 的右侧（side=0）或下方（side=1）边界上的入口
+void hpa_build_border(int k, int side) {
+    vector<pair<int, int>>& ent = hpa_border[side][k];
+    ent.clear();
+    int cr = k / HPA_KC, cc = k % HPA_KC;
+    if ((side == 0 && cc + 1 >= HPA_KC) || (side == 1 && cr + 1 >= HPA_KR)) return;
+
+    // 沿边界逐格扫描，(ax,ay) 在本簇，(bx,by) 在邻簇
+    int len = side == 0 ? min(HPA_C, MAP_ROWS - cr * HPA_C) : min(HPA_C, N - cc * HPA_C);
+    int run_start = -1;
+    for (int t = 0; t <= len; t++) {
+        bool open = false;
+        int ax = 0, ay = 0;
+        if (t < len) {
+            ax = side == 0 ? cr * HPA_C + t : (cr + 1) * HPA_C - 1;
+            ay = side == 0 ? (cc + 1) * HPA_C - 1 : cc * HPA_C + t;
+            open = static_passable(ax, ay) && static_passable(ax + (side == 1), ay + (side == 0));
+        }
+        if (open && run_start == -1) run_start = t;
+        if (!open && run_start != -1) {
+            int run_end = t - 1;
+            int picks[2] = {(run_start + run_end) / 2, -1};
+            if (run_end - run_start + 1 >= HPA_LONG_ENTRANCE) {
+                picks[0] = run_start;
+                picks[1] = run_end;
+            }
+            for (int p : picks) {
+                if (p == -1) continue;
+                int px = side == 0 ? cr * HPA_C + p : (cr + 1) * HPA_C - 1;
+                int py = side == 0 ? (cc + 1) * HPA_C - 1 : cc * HPA_C + p;
+                ent.push_back({px * N + py, (px + (side == 1)) * N + py + (side == 0)});
+            }
+            run_start = -1;
+        }
+    }
+}
+
+// 簇内BFS：从格子 src 出发，只在簇 k 内扩展，结果留在 search_ws（visited/g/from_dir，按结点编号索引）
+// dynamic 为 true 时把 occupied 视为障碍
+void hpa_local_bfs(int k, int src, bool dynamic) {
+    int x0 = (k / HPA_KC) * HPA_C, y0 = (k % HPA_KC) * HPA_C;
+    int x1 = min(x0 + HPA_C, MAP_ROWS), y1 = min(y0 + HPA_C, N);
+    int sv = node_of[src];
+    search_ws.begin();
+    search_ws.visit(sv, -1);
+    search_ws.g[sv] = 0;
+    search_ws.push(sv);
+    while (!search_ws.empty()) {
+        int curr = search_ws.pop();
+        const int* nb = &adj[4 * curr];
+        for (int i = 0; i < 4; i++) {
+            int v = nb[i];
+            if (v == -1 || search_ws.visited(v)) continue;
+            int nx = node_x[v], ny = node_y[v];
+            if (nx < x0 || nx >= x1 || ny < y0 || ny >= y1) continue;
+            if (dynamic && node_occupied(v)) continue;
+            search_ws.visit(v, i);
+            search_ws.g[v] = search_ws.g[curr] + 1;
+            search_ws.push(v);
+        }
+    }
+}
+
+// 重建簇 k 的抽象结点及簇内距离表
+void hpa_build_cluster(int k) {
+    HpaCluster& cl = hpa_clusters[k];
+    for (int c : cl.cells) hpa_node_local[c] = -1;
+    cl.cells.clear();
+    cl.partners.clear();
+
+    int cr = k / HPA_KC, cc = k % HPA_KC;
+    auto add_link = [&](int mine, int other) {
+        if (hpa_node_local[mine] == -1) {
+            hpa_node_local[mine] = cl.cells.size();
+            cl.cells.push_back(mine);
+            cl.partners.push_back(vector<int>());
+        }
+        cl.partners[hpa_node_local[mine]].push_back(other);
+    };
+    for (auto& e : hpa_border[0][k]) add_link(e.first, e.second);
+    for (auto& e : hpa_border[1][k]) add_link(e.first, e.second);
+    if (cc > 0) for (auto& e : hpa_border[0][k - 1]) add_link(e.second, e.first);
+    if (cr > 0) for (auto& e : hpa_border[1][k - HPA_KC]) add_link(e.second, e.first);
+
+    int m = cl.cells.size();
+    cl.dist.assign(m * m, -1);
+    for (int a = 0; a < m; a++) {
+        hpa_local_bfs(k, cl.cells[a], false);
+        for (int b = 0; b < m; b++) {
+            int v = node_of[cl.cells[b]];
+            if (search_ws.visited(v)) cl.dist[a * m + b] = search_ws.g[v];
+        }
+    }
+}
+
+// 重新计算全局结点编号偏移，并调整抽象搜索数组大小
+void hpa_update_offsets() {
+    hpa_offset[0] = 0;
+    for (int k = 0; k < HPA_KN; k++) {
+        hpa_offset[k + 1] = hpa_offset[k] + hpa_clusters[k].cells.size();
+    }
+    int total = hpa_offset[HPA_KN] + 1;
+    hpa_g.resize(total);
+    hpa_first.resize(total);
+    hpa_dt.resize(total);
+    hpa_stamp.resize(total, 0);
+}
+
+// 构建整个分层结构（load_map 之后调用一次）
+void init_hpa() {
+    HPA_KR = (MAP_ROWS + HPA_C - 1) / HPA_C;
+    HPA_KC = (N + HPA_C - 1) / HPA_C;
+    HPA_KN = HPA_KR * HPA_KC;
+    hpa_clusters.assign(HPA_KN, HpaCluster());
+    hpa_border[0].assign(HPA_KN, vector<pair<int, int>>());
+    hpa_border[1].assign(HPA_KN, vector<pair<int, int>>());
+    hpa_node_local.assign(CELL_COUNT, -1);
+    hpa_offset.assign(HPA_KN + 1, 0);
+    for (int k = 0; k < HPA_KN; k++) {
+        hpa_build_border(k, 0);
+        hpa_build_border(k, 1);
+    }
+    for (int k = 0; k < HPA_KN; k++) hpa_build_cluster(k);
+    hpa_update_offsets();
+}
+
+// 簇(cr,cc)内地形发生变化后调用：只重建与它相关的四条边界，以及它和四个相邻簇的结点与距离表
+void hpa_refresh_cluster(int cr, int cc) {
+    int k = cr * HPA_KC + cc;
+    hpa_build_border(k, 0);
+    hpa_build_border(k, 1);
+    if (cc > 0) hpa_build_border(k - 1, 0);
+    if (cr > 0) hpa_build_border(k - HPA_KC, 1);
+    hpa_build_cluster(k);
+    if (cc > 0) hpa_build_cluster(k - 1);
+    if (cc + 1 < HPA_KC) hpa_build_cluster(k + 1);
+    if (cr > 0) hpa_build_cluster(k - HPA_KC);
+    if (cr + 1 < HPA_KR) hpa_build_cluster(k + HPA_KC);
+    hpa_update_offsets();
+}
+
+// 分层寻路：返回值约定与 bfs() 相同
+int hpa_plan(int start_x, int start_y, int target_x, int target_y) {
+    if (start_x == target_x && start_y == target_y) return -1;
+    int start = start_x * N + start_y;
+    int target = target_x * N + target_y;
+    int ks = hpa_cluster_of(start), kt = hpa_cluster_of(target);
+    int goal = hpa_offset[HPA_KN];  // 虚拟终点结点
+
+    // 终点簇内：各结点到终点的静态距离
+    HpaCluster& ct = hpa_clusters[kt];
+    hpa_local_bfs(kt, target, false);
+    for (int j = 0; j < (int)ct.cells.size(); j++) {
+        int v = node_of[ct.cells[j]];
+        hpa_dt[hpa_offset[kt] + j] = search_ws.visited(v) ? search_ws.g[v] : -1;
+    }
+
+    // 起点簇内（考虑占用）：同簇且可直接到达时直接返回；否则作为抽象搜索的起始代价
+    // 该次BFS的 from_dir 保留到最后用于细化第一段路径
+    hpa_local_bfs(ks, start, true);
+    if (ks == kt && search_ws.visited(node_of[target])) return first_step(node_of[start], node_of[target]);
+
+    if (++hpa_epoch == 0) {
+        fill(hpa_stamp.begin(), hpa_stamp.end(), 0);
+        hpa_epoch = 1;
+    }
+    hpa_heap.clear();
+    auto relax = [&](int v, int gv, int first, int vcell) {
+        if (hpa_stamp[v] == hpa_epoch && hpa_g[v] <= gv) return;
+        hpa_stamp[v] = hpa_epoch;
+        hpa_g[v] = gv;
+        hpa_first[v] = first;
+        int h = v == goal ? 0 : abs(vcell / N - target_x) + abs(vcell % N - target_y);
+        hpa_heap.push_back(((unsigned long long)(gv + h) << 32) | (unsigned int)v);
+        push_heap(hpa_heap.begin(), hpa_heap.end(), greater<unsigned long long>());
+    };
+
+    HpaCluster& cs = hpa_clusters[ks];
+    for (int j = 0; j < (int)cs.cells.size(); j++) {
+        int c = cs.cells[j];
+        int v = node_of[c];
+        if (!search_ws.visited(v)) continue;
+        int gs = search_ws.g[v];
+        relax(hpa_offset[ks] + j, gs, gs == 0 ? -1 : c, c);
+    }
+
+    int first = -1;
+    while (!hpa_heap.empty()) {
+        pop_heap(hpa_heap.begin(), hpa_heap.end(), greater<unsigned long long>());
+        unsigned long long top = hpa_heap.back();
+        hpa_heap.pop_back();
+        int u = (int)(top & 0xFFFFFFFFu);
+        int fu = (int)(top >> 32);
+        if (u == goal) { first = hpa_first[u]; break; }
+
+        int k = upper_bound(hpa_offset.begin(), hpa_offset.end(), u) - hpa_offset.begin() - 1;
+        int li = u - hpa_offset[k];
+        HpaCluster& cl = hpa_clusters[k];
+        int c = cl.cells[li];
+        int gu = hpa_g[u];
+        if (fu > gu + abs(c / N - target_x) + abs(c % N - target_y)) continue;  // 过期条目
+        int fst = hpa_first[u];
+
+        if (k == kt && hpa_dt[u] >= 0) relax(goal, gu + hpa_dt[u], fst, target);
+        // 起点所在结点的簇内出边已由起点BFS覆盖，只走跨边界的边
+        if (fst != -1) {
+            int m = cl.cells.size();
+            for (int lj = 0; lj < m; lj++) {
+                int d = cl.dist[li * m + lj];
+                if (lj == li || d < 0) continue;
+                relax(hpa_offset[k] + lj, gu + d, fst, cl.cells[lj]);
+            }
+        }
+        for (int p : cl.partners[li]) {
+            if (occupied_cell(p) && fst == -1) continue;  // 紧邻起点的一步必须可走
+            int kp = hpa_cluster_of(p);
+            relax(hpa_offset[kp] + hpa_node_local[p], gu + 1, fst == -1 ? p : fst, p);
+        }
+    }
+    if (first == -1) return -1;
+
+    // 细化：第一段终点若与起点相邻（跨边界的一步）直接给出方向，否则沿起点簇内BFS回溯
+    for (int i = 0; i < 4; i++) {
+        if (start_x + dx[i] == first / N && start_y + dy[i] == first % N) return i;
+    }
+    if (!search_ws.visited(node_of[first])) return -1;
+    return first_step(node_of[start], node_of[first]);
+}
+
+// ========== 窗口化协作A*（WHCA*） ==========
+// 按 p_order 的优先级顺序，每个机器人在时空 (格子, 时刻t) 上做A*，只规划未来 coop_window 帧；
+// 规划好的路径写入扁平的时空预约表，后续机器人规划时避开已预约的 (格子, t)，
+// 并禁止与已预约路径在同一帧对穿（边交换冲突）。t=1 额外遵守判题规则：不能走进 occupied 的格子。
+// 超出窗口的部分用启发函数（目标的静态距离场）估计。预约表用帧号做戳，每帧无需清空。
+// 默认开启，开启时取代逐机器人寻路 plan_step（--planner 只在 --coop 0 时生效）。
+const int COOP_MAX_WINDOW = 16;
+int coop_window = 8;                  // 窗口长度，0表示关闭；命令行 --coop W 设置
+// 时域 st_horizon 取 coop_window 与 CBS 时域的较大者。预约表是以 t*CELL_COUNT+格子 为键的开放寻址哈希表
+// （每帧至多 ROBOT_NUM*(时域+1) 项，容量取其4倍以上）；时空搜索只会走到起点曼哈顿距离 t 以内的格子，
+// 状态按以起点为中心、边长 2*时域+1 的局部窗口编号，共 (时域+1)*(2*时域+1)^2 项。
+// 二者都在 init_search_tables 时按舰队规模与时域分配，与地图尺寸无关。
+struct ResSlot {
+    int frame;                        // 该槽所属帧号，不等于当前帧号即为空槽
+    int key;                          // t*CELL_COUNT + 格子
+    int owner;                        // 占用该 (t, 格子) 的机器人编号
+};
+vector<ResSlot> res_table;
+unsigned int res_mask = 0;
+int st_horizon = 0;
+int st_span = 1;                      // 局部窗口边长 2*st_horizon+1
+vector<unsigned int> st_stamp;        // 时空搜索的访问戳
+vector<int> st_parent;                // 时空搜索的父状态
+unsigned int st_epoch = 0;
+vector<unsigned long long> st_heap;
+int coop_path[COOP_MAX_WINDOW + 1];   // 最近一次规划得到的路径：coop_path[t] 为t时刻所在格子
+bool coop_path_valid = false;
+
+inline unsigned int res_hash(int key) { return ((unsigned int)key * 2654435761u) & res_mask; }
+
+inline void reserve_cell(int t, int c, int robot) {
+    int key = t * CELL_COUNT + c;
+    unsigned int h = res_hash(key);
+    while (res_table[h].frame == frame_id && res_table[h].key != key) h = (h + 1) & res_mask;
+    res_table[h].frame = frame_id;
+    res_table[h].key = key;
+    res_table[h].owner = robot;
+}
+
+// (t, c) 被哪个机器人预约，-1表示没有
+inline int reserved_by(int t, int c) {
+    int key = t * CELL_COUNT + c;
+    for (unsigned int h = res_hash(key); res_table[h].frame == frame_id; h = (h + 1) & res_mask) {
+        if (res_table[h].key == key) return res_table[h].owner;
+    }
+    return -1;
+}
+
+// 每帧开始时调用：所有机器人在 t=0 预约当前位置，不可用的机器人预约整个窗口
+void coop_begin_frame() {
+    for (int j = 0; j < ROBOT_NUM; j++) {
+        int c = robots[j].x * N + robots[j].y;
+        int until = robots[j].status == 0 ? coop_window : 0;
+        for (int t = 0; t <= until; t++) reserve_cell(t, c, j);
+    }
+}
+
+// CBS 的约束：禁止 agent 在 t 时刻位于 cell
+struct CbsConstraint {
+    int agent, t, cell;
+};
+
+// 时空A*（协作规划与CBS底层共用）
+// 从 robot 当前位置出发、以 h_field（目标的静态距离场）为启发，规划 horizon 帧内前往 target 的路径，
+// 结果写入 coop_path[0..horizon]，返回路径代价（到达时刻，或 horizon+剩余估计），无解返回-1。
+//   use_res: 是否避让时空预约表中其他机器人的预约（协作规划）；
+//   cons:    CBS 约束列表（可为 nullptr）；
+//   blocked: 在 t>=2 时视为障碍的格子标记（可为 nullptr），t=1 总是遵守 occupied。
+long long st_expanded = 0;            // 时空搜索累计扩展的状态数，CBS 用来控制每帧预算
+int space_time_astar(int robot, int target, const int* h_field, int horizon, bool use_res,
+                     const vector<CbsConstraint>* cons, const unsigned int* blocked, unsigned int blocked_tag) {
+    coop_path_valid = false;
+    int sx = robots[robot].x, sy = robots[robot].y;
+    int start = sx * N + sy;
+    if (h_field[start] < 0) return -1;
+    // 局部窗口编号：l = (x-sx+H)*S + (y-sy+H)，状态编号 = t*S*S + l
+    const int H = st_horizon, S = st_span, S2 = st_span * st_span;
+    auto cell_at = [&](int l) { return (l / S + sx - H) * N + (l % S + sy - H); };
+
+    if (++st_epoch == 0) {
+        fill(st_stamp.begin(), st_stamp.end(), 0);
+        st_epoch = 1;
+    }
+    st_heap.clear();
+    // 堆键：(f, 255-t, 状态编号)，f 相同时优先扩展时间更晚的状态
+    auto push = [&](int t, int l, int c, int parent) {
+        int st = t * S2 + l;
+        st_stamp[st] = st_epoch;
+        st_parent[st] = parent;
+        unsigned long long f = t + h_field[c];
+        st_heap.push_back((f << 40) | ((unsigned long long)(255 - t) << 32) | (unsigned int)st);
+        push_heap(st_heap.begin(), st_heap.end(), greater<unsigned long long>());
+    };
+    push(0, H * S + H, start, -1);
+
+    while (!st_heap.empty()) {
+        pop_heap(st_heap.begin(), st_heap.end(), greater<unsigned long long>());
+        unsigned long long key = st_heap.back();
+        int st = (int)(key & 0xFFFFFFFFu);
+        st_heap.pop_back();
+        int t = st / S2, l = st % S2, c = cell_at(l);
+        st_expanded++;
+
+        // 到达目标或到达窗口边界：回溯路径，到达目标后在窗口剩余时间内原地停留
+        if (c == target || t == horizon) {
+            for (int s = st; s != -1; s = st_parent[s]) coop_path[s / S2] = cell_at(s % S2);
+            for (int u = t + 1; u <= horizon; u++) coop_path[u] = c;
+            coop_path_valid = true;
+            return (int)(key >> 40);
+        }
+
+        int v = node_of[c];
+        for (int i = 0; i <= 4; i++) {
+            // i=4 表示原地等待
+            int nv = i < 4 ? adj[4 * v + i] : v;
+            if (nv == -1) continue;
+            int nc = cell_of[nv];
+            if (h_field[nc] < 0) continue;
+            int nt = t + 1;
+            int nl = i < 4 ? l + dx[i] * S + dy[i] : l;
+            if (st_stamp[nt * S2 + nl] == st_epoch) continue;
+            if (nt == 1 && nc != start && node_occupied(nv)) continue;
+            if (nt >= 2 && blocked && blocked[nc] == blocked_tag) continue;
+            if (use_res) {
+                int owner = reserved_by(nt, nc);
+                if (owner != -1 && owner != robot) continue;
+                // 跟随冲突：判题规则下不能走进上一时刻有其他机器人的格子（即使它同时离开），
+                // 对穿（边交换）是其特例
+                int prev = reserved_by(t, nc);
+                if (prev != -1 && prev != robot) continue;
+            }
+            if (cons) {
+                bool banned = false;
+                for (const auto& k : *cons) {
+                    if (k.agent == robot && k.t == nt && k.cell == nc) {
+                        banned = true;
+                        break;
+                    }
+                }
+                if (banned) continue;
+            }
+            push(nt, nl, nc, st);
+        }
+    }
+    return -1;
+}
+
+// 由路径的前两格得到第一步方向，-1表示原地等待
+int path_first_dir(const int* path) {
+    for (int i = 0; i < 4; i++) {
+        if (path[0] + dx[i] * N + dy[i] == path[1]) return i;
+    }
+    return -1;
+}
+
+// 为机器人 robot 规划前往 (target_x, target_y) 的协作路径，h_field 为目标的静态距离场
+// 返回第一步方向（0-3），-1表示原地等待或无解；规划结果保存在 coop_path 中，由 coop_commit() 写入预约表
+int coop_step(int robot, int target_x, int target_y, const int* h_field) {
+    if (space_time_astar(robot, target_x * N + target_y, h_field, coop_window, true, nullptr, nullptr, 0) < 0) return -1;
+    return path_first_dir(coop_path);
+}
+
+// 机器人本帧的实际动作确定后调用，把未来窗口内的位置写入预约表
+// 若实际走的就是规划的第一步，则预约整条规划路径；否则假设机器人停在 final_cell
+void coop_commit(int robot, int final_cell) {
+    bool follow = coop_path_valid && coop_path[1] == final_cell;
+    for (int t = 1; t <= coop_window; t++) {
+        reserve_cell(t, follow ? coop_path[t] : final_cell, robot);
+    }
+    coop_path_valid = false;
+}
+
+// ========== 冲突搜索（CBS）多机规划 ==========
+// 当若干机器人彼此靠得很近（拥堵区）时，顺序的优先级规划容易互相堵死。
+// 对每个拥堵区内的机器人在短时域内运行 CBS：底层为每个机器人做带约束的时空A*，
+// 高层检查路径间的冲突，并分裂出各加一条约束的子结点，按总代价最小优先扩展。
+// 冲突有两类：点冲突（同一时刻同一格子），以及跟随冲突（走进对方上一时刻所在的格子，
+// 判题规则不允许，对穿是其特例）。
+// 每帧有扩展预算，超出预算则放弃，该区域回退到原有的优先级顺序规划。
+// 默认关闭：在 100×100 与 400×400 的地图上实测，开启后得分没有提高。
+int cbs_threshold = 0;                 // 拥堵区内机器人数达到该值才启用 CBS，0表示关闭；命令行 --cbs K
+const int CBS_ZONE_RADIUS = 3;         // 曼哈顿距离不超过该值的机器人视为相互拥堵
+const int CBS_HORIZON = 6;             // CBS 规划的时域长度
+const int CBS_MAX_NODES = 64;          // 每个拥堵区最多扩展的高层结点数
+const long long CBS_FRAME_BUDGET = 30000;  // 每帧底层时空搜索最多扩展的状态数
+
+vector<int> cbs_move;                             // CBS 给出的本帧移动方向，-1表示等待
+vector<bool> cbs_assigned;                        // 该机器人本帧是否由 CBS 决定
+vector<vector<int>> cbs_paths;                    // CBS 给出的时空路径，用于写入预约表
+vector<unsigned int> cbs_block;                   // 拥堵区外机器人所在格子（t>=2 时视为障碍）
+unsigned int cbs_block_tag = 0;
+
+struct CbsNode {
+    vector<CbsConstraint> cons;
+    vector<vector<int>> paths;    // 与 agents 对应
+    vector<int> costs;
+    int total;
+};
+
+// 对一个拥堵区（agents）求解；goal_cell/goal_field 为每个机器人的目标与距离场
+// 成功时写入 cbs_move/cbs_paths 并返回 true
+bool cbs_solve(const vector<int>& agents, const vector<int>& goal_cell, const vector<const int*>& goal_field,
+               long long budget_end) {
+    int m = agents.size();
+    // 拥堵区外的机器人在整个时域内视为静止障碍
+    cbs_block_tag++;
+    vector<bool> in_zone(ROBOT_NUM, false);
+    for (int a : agents) in_zone[a] = true;
+    for (int j = 0; j < ROBOT_NUM; j++) {
+        if (!in_zone[j]) cbs_block[robots[j].x * N + robots[j].y] = cbs_block_tag;
+    }
+
+    vector<CbsNode> nodes;
+    nodes.reserve(CBS_MAX_NODES * 2 + 1);
+    CbsNode root;
+    root.paths.resize(m);
+    root.costs.resize(m);
+    root.total = 0;
+    for (int k = 0; k < m; k++) {
+        int a = agents[k];
+        int cost = space_time_astar(a, goal_cell[a], goal_field[a], CBS_HORIZON, false, nullptr, cbs_block.data(), cbs_block_tag);
+        if (cost < 0) return false;
+        root.paths[k].assign(coop_path, coop_path + CBS_HORIZON + 1);
+        root.costs[k] = cost;
+        root.total += cost;
+    }
+    nodes.push_back(root);
+
+    // 开放列表：(总代价, 结点下标)
+    vector<pair<int, int>> open;
+    open.push_back({root.total, 0});
+    int expanded = 0;
+    while (!open.empty() && expanded < CBS_MAX_NODES && st_expanded < budget_end) {
+        pop_heap(open.begin(), open.end(), greater<pair<int, int>>());
+        int id = open.back().second;
+        open.pop_back();
+        expanded++;
+
+        // 找第一个冲突：(ca, ct) 与 (cb, cbt) 为需要分别禁止的两个“智能体-时刻”，cbt=0 表示该分支不存在
+        int ca = -1, cb = -1, ct = -1, cbt = -1;
+        for (int t = 1; t <= CBS_HORIZON && ca == -1; t++) {
+            for (int p = 0; p < m && ca == -1; p++) {
+                for (int q = 0; q < m; q++) {
+                    if (q == p) continue;
+                    const vector<int>& pp = nodes[id].paths[p];
+                    const vector<int>& pq = nodes[id].paths[q];
+                    if (q > p && pp[t] == pq[t]) {
+                        ca = p; cb = q; ct = t; cbt = t;
+                        break;
+                    }
+                    if (pp[t] != pp[t - 1] && pp[t] == pq[t - 1]) {
+                        // p 在 t 时刻走进 q 在 t-1 时刻的格子：要么禁止 p 此时进入，要么禁止 q 提前停在那里
+                        ca = p; cb = q; ct = t; cbt = t - 1;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (ca == -1) {
+            // 无冲突：采用该结点的路径
+            for (int k = 0; k < m; k++) {
+                int a = agents[k];
+                cbs_assigned[a] = true;
+                cbs_paths[a] = nodes[id].paths[k];
+                cbs_move[a] = path_first_dir(cbs_paths[a].data());
+            }
+            return true;
+        }
+
+        // 分裂：分别给冲突双方之一加约束
+        for (int side = 0; side < 2; side++) {
+            int k = side == 0 ? ca : cb;
+            int t = side == 0 ? ct : cbt;
+            if (t == 0) continue;  // 初始位置无法约束
+            int a = agents[k];
+            CbsNode child;
+            child.cons = nodes[id].cons;
+            child.cons.push_back({a, t, nodes[id].paths[k][t]});
+            int cost = space_time_astar(a, goal_cell[a], goal_field[a], CBS_HORIZON, false, &child.cons, cbs_block.data(), cbs_block_tag);
+            if (cost < 0) continue;
+            child.paths = nodes[id].paths;
+            child.costs = nodes[id].costs;
+            child.paths[k].assign(coop_path, coop_path + CBS_HORIZON + 1);
+            child.total = nodes[id].total - child.costs[k] + cost;
+            child.costs[k] = cost;
+            nodes.push_back(child);
+            open.push_back({child.total, (int)nodes.size() - 1});
+            push_heap(open.begin(), open.end(), greater<pair<int, int>>());
+        }
+    }
+    return false;
+}
+
+// 每帧在机器人处理阶段之前调用：找出拥堵区并尝试用 CBS 求解
+// goal_cell/goal_field 为 -1/nullptr 的机器人（无目标或本帧执行 get/pull）不参与
+void cbs_plan_frame(const vector<int>& goal_cell, const vector<const int*>& goal_field) {
+    fill(cbs_assigned.begin(), cbs_assigned.end(), false);
+    if (cbs_threshold <= 0) return;
+
+    // 并查集按距离把有目标的机器人聚成拥堵区
+    vector<int> parent(ROBOT_NUM);
+    for (int i = 0; i < ROBOT_NUM; i++) parent[i] = i;
+    function<int(int)> find = [&](int v) { return parent[v] == v ? v : parent[v] = find(parent[v]); };
+    for (int i = 0; i < ROBOT_NUM; i++) {
+        if (goal_cell[i] == -1) continue;
+        for (int j = i + 1; j < ROBOT_NUM; j++) {
+            if (goal_cell[j] == -1) continue;
+            if (abs(robots[i].x - robots[j].x) + abs(robots[i].y - robots[j].y) <= CBS_ZONE_RADIUS) {
+                parent[find(i)] = find(j);
+            }
+        }
+    }
+
+    long long budget_end = st_expanded + CBS_FRAME_BUDGET;
+    for (int r = 0; r < ROBOT_NUM; r++) {
+        if (goal_cell[r] == -1 || find(r) != r) continue;
+        vector<int> agents;
+        for (int i = 0; i < ROBOT_NUM; i++) {
+            if (goal_cell[i] != -1 && find(i) == r) agents.push_back(i);
+        }
+        if ((int)agents.size() < cbs_threshold) continue;
+        if (st_expanded >= budget_end || frame_deadline_passed()) break;
+        cbs_solve(agents, goal_cell, goal_field, budget_end);
+    }
+
+    // CBS 决定的下一步格子先行占用，使其余机器人按优先级规划时避开
+    for (int i = 0; i < ROBOT_NUM; i++) {
+        if (cbs_assigned[i] && cbs_move[i] != -1) {
+            mark_occupied(robots[i].x + dx[cbs_move[i]], robots[i].y + dy[cbs_move[i]]);
+        }
+    }
+}
+
+// ========== D* Lite 增量寻路 ==========
+// 每个机器人持有自己的 D* Lite 状态（Robot::search），从目标反向搜索。
+// 目标不变时，每帧只把与上次相比占用状态发生变化的格子（其他机器人出现/离开）及其邻居重新更新，
+// 再修复最短路，代价与变化量成正比；只有目标（分配）改变时才从头搜索。
+const int DSTAR_INF = 0x3f3f3f3f;
+vector<unsigned int> dstar_mark;              // 对比占用变化时使用的临时标记（按结点编号）
+unsigned int dstar_mark_epoch = 0;
+vector<int> dstar_now_blocked;                // 本帧的动态障碍结点（各机器人共用的临时数组）
+vector<int> dstar_changed;                    // 占用状态发生变化的结点（同上）
+
+// 以下 D* Lite 函数中的 u、v、start、target 均为压缩可走图的结点编号
+inline int dstar_h(int a, int b) {
+    return abs(node_x[a] - node_x[b]) + abs(node_y[a] - node_y[b]);
+}
+
+// 对该搜索状态而言结点 v 是否可走：不是哨兵且不在记录的动态障碍中
+inline bool dstar_free(const DStarLite& ds, int v) {
+    return v != -1 && !ds.blocked[v];
+}
+
+pair<int, int> dstar_key(const DStarLite& ds, int start, int u) {
+    int m = min(ds.g[u], ds.rhs[u]);
+    if (m >= DSTAR_INF) return {DSTAR_INF, DSTAR_INF};
+    return {m + dstar_h(start, u) + ds.km, m};
+}
+
+void dstar_push(DStarLite& ds, int start, int u) {
+    ds.key[u] = dstar_key(ds, start, u);
+    ds.in_open[u] = 1;
+    ds.open.push_back({ds.key[u], u});
+    push_heap(ds.open.begin(), ds.open.end(), greater<pair<pair<int, int>, int>>());
+}
+
+// 重新计算 u 的 rhs，并按是否一致决定其是否留在开放列表中
+void dstar_update(DStarLite& ds, int start, int u) {
+    if (u != ds.target) {
+        int best = DSTAR_INF;
+        if (dstar_free(ds, u)) {
+            const int* nb = &adj[4 * u];
+            for (int i = 0; i < 4; i++) {
+                int v = nb[i];
+                if (dstar_free(ds, v) && ds.g[v] < DSTAR_INF) best = min(best, ds.g[v] + 1);
+            }
+        }
+        ds.rhs[u] = best;
+    }
+    if (ds.g[u] != ds.rhs[u]) dstar_push(ds, start, u);
+    else ds.in_open[u] = 0;
+}
+
+// 更新 u 的所有邻居（它们以 u 为后继）
+void dstar_update_neighbors(DStarLite& ds, int start, int u) {
+    const int* nb = &adj[4 * u];
+    for (int i = 0; i < 4; i++) {
+        if (nb[i] != -1) dstar_update(ds, start, nb[i]);
+    }
+}
+
+void dstar_compute(DStarLite& ds, int start) {
+    while (!ds.open.empty()) {
+        auto top = ds.open.front();
+        int u = top.second;
+        if (!ds.in_open[u] || ds.key[u] != top.first) {
+            // 过期条目
+            pop_heap(ds.open.begin(), ds.open.end(), greater<pair<pair<int, int>, int>>());
+            ds.open.pop_back();
+            continue;
+        }
+        if (!(top.first < dstar_key(ds, start, start)) && ds.rhs[start] == ds.g[start]) break;
+        pop_heap(ds.open.begin(), ds.open.end(), greater<pair<pair<int, int>, int>>());
+        ds.open.pop_back();
+
+        pair<int, int> k_new = dstar_key(ds, start, u);
+        if (top.first < k_new) {
+            dstar_push(ds, start, u);
+        } else if (ds.g[u] > ds.rhs[u]) {
+            ds.in_open[u] = 0;
+            ds.g[u] = ds.rhs[u];
+            dstar_update_neighbors(ds, start, u);
+        } else {
+            ds.in_open[u] = 0;
+            ds.g[u] = DSTAR_INF;
+            dstar_update(ds, start, u);
+            dstar_update_neighbors(ds, start, u);
+        }
+    }
+}
+
+// D* Lite 寻路：返回值约定与 bfs() 相同；搜索状态保存在 robots[robot].search 中
+int dstar_step(int robot, int target_x, int target_y) {
+    DStarLite& ds = robots[robot].search;
+    int start = node_of[robots[robot].x * N + robots[robot].y];
+    int target = node_of[target_x * N + target_y];
+    if (start == -1 || target == -1) return -1;
+    if (start == target) return -1;
+
+    if (ds.g.empty()) {
+        ds.g.assign(node_count, DSTAR_INF);
+        ds.rhs.assign(node_count, DSTAR_INF);
+        ds.key.assign(node_count, make_pair(0, 0));
+        ds.in_open.assign(node_count, 0);
+        ds.blocked.assign(node_count, 0);
+    }
+
+    // 本帧的动态障碍：occupied 中仍被占用的格子（起点已被临时释放）
+    if (++dstar_mark_epoch == 0) {
+        fill(dstar_mark.begin(), dstar_mark.end(), 0);
+        dstar_mark_epoch = 1;
+    }
+    vector<int>& now_blocked = dstar_now_blocked;
+    now_blocked.clear();
+    for (int c : occupied_list) {
+        int v = node_of[c];
+        if (v != -1 && occupied_cell(c) && dstar_mark[v] != dstar_mark_epoch) {
+            dstar_mark[v] = dstar_mark_epoch;
+            now_blocked.push_back(v);
+        }
+    }
+
+    if (ds.target != target) {
+        // 目标改变：从头初始化
+        fill(ds.g.begin(), ds.g.end(), DSTAR_INF);
+        fill(ds.rhs.begin(), ds.rhs.end(), DSTAR_INF);
+        fill(ds.in_open.begin(), ds.in_open.end(), 0);
+        ds.open.clear();
+        for (int v : ds.blocked_list) ds.blocked[v] = 0;
+        for (int v : now_blocked) ds.blocked[v] = 1;
+        ds.blocked_list = now_blocked;
+        ds.km = 0;
+        ds.target = target;
+        ds.last_start = start;
+        ds.rhs[target] = 0;
+        dstar_push(ds, start, target);
+    } else {
+        // 目标不变：修正键值偏移，只更新占用状态变化的结点及其邻居
+        ds.km += dstar_h(ds.last_start, start);
+        ds.last_start = start;
+        vector<int>& changed = dstar_changed;
+        changed.clear();
+        for (int v : ds.blocked_list) {
+            if (dstar_mark[v] != dstar_mark_epoch) changed.push_back(v);
+        }
+        for (int v : now_blocked) {
+            if (!ds.blocked[v]) changed.push_back(v);
+        }
+        for (int v : changed) ds.blocked[v] ^= 1;
+        ds.blocked_list = now_blocked;
+        for (int v : changed) {
+            dstar_update(ds, start, v);
+            dstar_update_neighbors(ds, start, v);
+        }
+    }
+
+    dstar_compute(ds, start);
+
+    // 只需要第一步：从起点沿 g 值下降一步（完整路径隐含在 g 值中，下一帧修复后再取）
+    if (ds.rhs[start] >= DSTAR_INF) return -1;
+    int best_g = DSTAR_INF, first_dir = -1;
+    const int* nb = &adj[4 * start];
+    for (int i = 0; i < 4; i++) {
+        int v = nb[i];
+        if (dstar_free(ds, v) && ds.g[v] < best_g) {
+            best_g = ds.g[v];
+            first_dir = i;
+        }
+    }
+    return first_dir;
+}
+
+// 按地图尺寸和舰队规模分配寻路工作区、时空表与 CBS/D* Lite 的辅助数组（load_map 之后调用一次）
+void init_search_tables() {
+    search_ws.init(node_count);
+    st_horizon = max(coop_window, CBS_HORIZON);
+    st_span = 2 * st_horizon + 1;
+    unsigned int cap = 16;
+    while (cap < 4u * ROBOT_NUM * (st_horizon + 1)) cap <<= 1;
+    res_table.assign(cap, ResSlot{0, 0, -1});
+    res_mask = cap - 1;
+    st_stamp.assign((size_t)(st_horizon + 1) * st_span * st_span, 0);
+    st_parent.assign((size_t)(st_horizon + 1) * st_span * st_span, -1);
+    st_epoch = 0;
+    cbs_move.assign(ROBOT_NUM, -1);
+    cbs_assigned.assign(ROBOT_NUM, false);
+    cbs_paths.assign(ROBOT_NUM, vector<int>());
+    cbs_block.assign(CELL_COUNT, 0);
+    dstar_mark.assign(node_count, 0);
+}
+
+// 寻路算法选择
+// plan_step 只在协作规划关闭（--coop 0）时才被调用：协作规划开启时机器人循环改用 coop_step，
+// 因此 --planner 需要与 --coop 0 一起使用才有效果。
+enum Planner { PLANNER_BFS, PLANNER_ASTAR, PLANNER_JPS, PLANNER_HPA, PLANNER_DSTAR };
+Planner planner_mode = PLANNER_ASTAR;   // 可通过命令行 --planner bfs|astar|jps|hpa|dstar 切换（需 --coop 0）
+
+// 机器人循环统一调用的寻路入口，按 planner_mode 分派到具体算法
+// robot 供持有搜索状态的算法（D* Lite）使用；h_field 仅对启发式算法有效，含义见 astar()
+int plan_step(int robot, int start_x, int start_y, int target_x, int target_y, const int* h_field) {
+    // 起点与目标不在同一连通块：不必搜索
+    if (comp_id[start_x * N + start_y] != comp_id[target_x * N + target_y]) return -1;
+    switch (planner_mode) {
+        case PLANNER_BFS: return bfs(start_x, start_y, target_x, target_y);
+        case PLANNER_ASTAR: return astar(start_x, start_y, target_x, target_y, h_field);
+        case PLANNER_JPS: return jps(start_x, start_y, target_x, target_y);
+        case PLANNER_HPA: return hpa_plan(start_x, start_y, target_x, target_y);
+        case PLANNER_DSTAR: return dstar_step(robot, target_x, target_y);
+    }
+    return -1;
+}
+
+// ========== 货物空间分桶 ==========
+// 每帧把货物按坐标放进 GOOD_BUCKET x GOOD_BUCKET 的桶里（计数排序，桶内按 goods_list 顺序）。
+// 为机器人生成候选时从它所在的桶按切比雪夫环向外搜索，只保留评分最高的 k 个（小根堆）；
+// 第 r 环中任意格子到机器人的曼哈顿距离至少为 (r-1)*GOOD_BUCKET+1，真实距离与地标下界都不小于它，
+// 因此第 r 环能达到的最高评分不超过 最大价值/(该下界+最小泊位距离+1)，堆满且它不超过堆顶时即可停止。
+// 取 k=ROBOT_NUM 不影响分配结果：任何机器人最终分到的货物都在它自己的前 ROBOT_NUM 名之内
+// （其他机器人最多占走 ROBOT_NUM-1 个更好的货物），贪心和最优匹配都是如此。
+// 堆不满时环形剪枝无法停止，因此累计已扫描的货物数，扫完全部货物即停止外扩；
+// 货物总数不超过 k 时（如机器人多于场上货物）直接线性扫描，不再逐环遍历空桶。
+const int GOOD_BUCKET = 8;
+int gb_rows = 0, gb_cols = 0;       // 桶的行数、列数
+vector<int> gb_start;               // 桶 b 的货物为 gb_items[gb_start[b] .. gb_start[b+1])
+vector<int> gb_items;               // 按桶排列的货物下标
+int gb_vmax = 0;                    // 本帧货物的最大价值
+int gb_bdmin = 0;                   // 本帧货物到泊位的最小距离
+
+// 每帧读入货物后调用：重建分桶
+void build_good_buckets() {
+    gb_rows = (MAP_ROWS + GOOD_BUCKET - 1) / GOOD_BUCKET;
+    gb_cols = (N + GOOD_BUCKET - 1) / GOOD_BUCKET;
+    gb_start.assign(gb_rows * gb_cols + 1, 0);
+    gb_items.resize(goods_list.size());
+    gb_vmax = 0;
+    gb_bdmin = -1;
+    for (const auto& g : goods_list) {
+        gb_start[(g.x / GOOD_BUCKET) * gb_cols + g.y / GOOD_BUCKET + 1]++;
+        gb_vmax = max(gb_vmax, g.val);
+        int bd = berth_dist[g.x * N + g.y];
+        if (bd != -1 && (gb_bdmin == -1 || bd < gb_bdmin)) gb_bdmin = bd;
+    }
+    if (gb_bdmin == -1) gb_bdmin = 0;
+    for (int b = 0; b < gb_rows * gb_cols; b++) gb_start[b + 1] += gb_start[b];
+    vector<int> pos(gb_start.begin(), gb_start.end() - 1);
+    for (int j = 0; j < (int)goods_list.size(); j++) {
+        gb_items[pos[(goods_list[j].x / GOOD_BUCKET) * gb_cols + goods_list[j].y / GOOD_BUCKET]++] = j;
+    }
+}
+
+// ========== 货物评分核（SoA + SIMD） ==========
+// 分桶时把货物按 gb_items 的顺序另存为结构数组（SoA）：坐标、价值、到泊位距离各占一段 32 字节对齐的缓冲区，
+// 末尾补到 8 的倍数（补位与到不了泊位的货物价值记 0）。评分核对一个机器人一次算 8 个（AVX2）或 4 个（SSE2）货物的
+// 乐观评分 价值*rcp(曼哈顿距离+泊位距离+1)；曼哈顿距离不超过真实距离与地标下界，所以它是 good_total_dist 评分的上界。
+// rcp 是近似倒数（相对误差不超过 1.5*2^-12），结果再乘 SOA_SCORE_SLACK 保证仍是上界；标量版本用同样的公式。
+// 环形搜索每到达一个桶才对该桶的货物调用评分核（SoA 按桶排列，桶内货物连续），用它跳过不可能进入前 k 名的货物，
+// 不再为它们查距离场或地标表，候选集合与逐个精确计算时完全一致；环形剪枝没有访问到的桶不做任何计算。
+// 向量版本把区间向外对齐到 8 个货物（缓冲区按 8 补齐，不会越界），多算的几项不影响结果。
+// 指令集在启动时按 CPU 支持情况选择，命令行 --simd scalar|sse2|avx2 可强制指定（不支持时退回标量）。
+const float SOA_SCORE_SLACK = 1.0f + 1.0f / 512;
+const int SOA_ALIGN = 32;
+
+// 按 SOA_ALIGN 对齐分配的 vector 分配器（多分配一段空间，把原始指针存在对齐地址之前）
+template<class T>
+struct AlignedAllocator {
+    typedef T value_type;
+    AlignedAllocator() {}
+    template<class U> AlignedAllocator(const AlignedAllocator<U>&) {}
+    T* allocate(size_t n) {
+        char* raw = static_cast<char*>(::operator new(n * sizeof(T) + SOA_ALIGN + sizeof(void*)));
+        size_t addr = (size_t)(raw + sizeof(void*) + SOA_ALIGN - 1) & ~(size_t)(SOA_ALIGN - 1);
+        reinterpret_cast<void**>(addr)[-1] = raw;
+        return reinterpret_cast<T*>(addr);
+    }
+    void deallocate(T* p, size_t) { ::operator delete(reinterpret_cast<void**>(p)[-1]); }
+};
+template<class T, class U>
+bool operator==(const AlignedAllocator<T>&, const AlignedAllocator<U>&) { return true; }
+template<class T, class U>
+bool operator!=(const AlignedAllocator<T>&, const AlignedAllocator<U>&) { return false; }
+
+typedef vector<int, AlignedAllocator<int>> AlignedInts;
+typedef vector<float, AlignedAllocator<float>> AlignedFloats;
+
+AlignedInts soa_x, soa_y, soa_val, soa_bd;  // 按 gb_items 顺序排列的货物坐标、价值、到泊位距离
+AlignedFloats soa_score;                    // 评分核输出：当前机器人对每个货物的乐观评分
+int soa_count = 0;                          // 补齐后的长度（8 的倍数）
+
+// 评分核：对机器人 (rx, ry) 计算 soa_score[t0 .. t1)
+void score_goods_scalar(int rx, int ry, int t0, int t1) {
+    for (int t = t0; t < t1; t++) {
+        int denom = abs(soa_x[t] - rx) + abs(soa_y[t] - ry) + soa_bd[t] + 1;
+        soa_score[t] = (float)soa_val[t] * (1.0f / (float)denom) * SOA_SCORE_SLACK;
+    }
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SOA_HAVE_X86 1
+
+__attribute__((target("sse2")))
+void score_goods_sse2(int rx, int ry, int t0, int t1) {
+    const __m128i vrx = _mm_set1_epi32(rx), vry = _mm_set1_epi32(ry), one = _mm_set1_epi32(1);
+    const __m128 slack = _mm_set1_ps(SOA_SCORE_SLACK);
+    for (int t = t0 & ~7; t < ((t1 + 7) & ~7); t += 4) {
+        __m128i ddx = _mm_sub_epi32(_mm_load_si128((const __m128i*)&soa_x[t]), vrx);
+        __m128i ddy = _mm_sub_epi32(_mm_load_si128((const __m128i*)&soa_y[t]), vry);
+        // SSE2 没有 abs_epi32：(v ^ s) - s，s 为符号位扩展
+        __m128i sx = _mm_srai_epi32(ddx, 31), sy = _mm_srai_epi32(ddy, 31);
+        ddx = _mm_sub_epi32(_mm_xor_si128(ddx, sx), sx);
+        ddy = _mm_sub_epi32(_mm_xor_si128(ddy, sy), sy);
+        __m128i denom = _mm_add_epi32(_mm_add_epi32(ddx, ddy),
+                                      _mm_add_epi32(_mm_load_si128((const __m128i*)&soa_bd[t]), one));
+        __m128 val = _mm_cvtepi32_ps(_mm_load_si128((const __m128i*)&soa_val[t]));
+        __m128 s = _mm_mul_ps(_mm_mul_ps(val, _mm_rcp_ps(_mm_cvtepi32_ps(denom))), slack);
+        _mm_store_ps(&soa_score[t], s);
+    }
+}
+
+__attribute__((target("avx2")))
+void score_goods_avx2(int rx, int ry, int t0, int t1) {
+    const __m256i vrx = _mm256_set1_epi32(rx), vry = _mm256_set1_epi32(ry), one = _mm256_set1_epi32(1);
+    const __m256 slack = _mm256_set1_ps(SOA_SCORE_SLACK);
+    for (int t = t0 & ~7; t < ((t1 + 7) & ~7); t += 8) {
+        __m256i ddx = _mm256_abs_epi32(_mm256_sub_epi32(_mm256_load_si256((const __m256i*)&soa_x[t]), vrx));
+        __m256i ddy = _mm256_abs_epi32(_mm256_sub_epi32(_mm256_load_si256((const __m256i*)&soa_y[t]), vry));
+        __m256i denom = _mm256_add_epi32(_mm256_add_epi32(ddx, ddy),
+                                         _mm256_add_epi32(_mm256_load_si256((const __m256i*)&soa_bd[t]), one));
+        __m256 val = _mm256_cvtepi32_ps(_mm256_load_si256((const __m256i*)&soa_val[t]));
+        __m256 s = _mm256_mul_ps(_mm256_mul_ps(val, _mm256_rcp_ps(_mm256_cvtepi32_ps(denom))), slack);
+        _mm256_store_ps(&soa_score[t], s);
+    }
+}
+#endif
+
+enum SimdMode { SIMD_AUTO, SIMD_SCALAR, SIMD_SSE2, SIMD_AVX2 };
+SimdMode simd_mode = SIMD_AUTO;  // 命令行 --simd 设置
+void (*score_goods)(int, int, int, int) = score_goods_scalar;
+
+// 启动时按 simd_mode 与 CPU 支持情况选择评分核
+void init_score_kernel() {
+    score_goods = score_goods_scalar;
+#ifdef SOA_HAVE_X86
+    __builtin_cpu_init();
+    bool avx2 = __builtin_cpu_supports("avx2");
+    bool sse2 = __builtin_cpu_supports("sse2");
+    if ((simd_mode == SIMD_AUTO || simd_mode == SIMD_AVX2) && avx2) score_goods = score_goods_avx2;
+    else if ((simd_mode == SIMD_AUTO || simd_mode == SIMD_SSE2) && sse2) score_goods = score_goods_sse2;
+#endif
+}
+
+// 分桶后调用：按 gb_items 的顺序填充 SoA 缓冲区
+void build_goods_soa() {
+    int n = gb_items.size();
+    soa_count = (n + 7) & ~7;
+    soa_x.assign(soa_count, 0);
+    soa_y.assign(soa_count, 0);
+    soa_val.assign(soa_count, 0);
+    soa_bd.assign(soa_count, 0);
+    soa_score.assign(soa_count, 0.0f);
+    for (int t = 0; t < n; t++) {
+        const Goods& g = goods_list[gb_items[t]];
+        int bd = berth_dist[g.x * N + g.y];
+        soa_x[t] = g.x;
+        soa_y[t] = g.y;
+        soa_val[t] = bd == -1 ? 0 : g.val;
+        soa_bd[t] = bd == -1 ? 0 : bd;
+    }
+}
+
+// 机器人 i 取货物 j 再送到泊位的总距离（人货距离 + 货到泊位距离），-1表示不可行
+// 人货距离：货物距离场已缓存时用真实距离，否则用地标距离下界
+int good_total_dist(int i, int j) {
+    const Goods& g = goods_list[j];
+    // 不在同一连通块的货物直接排除
+    if (g.comp != robots[i].comp) return -1;
+    int d;
+    const int* field = peek_good_field(g.x, g.y);
+    if (field) {
+        d = field[robots[i].x * N + robots[i].y];
+    } else {
+        d = alt_distance(robots[i].x, robots[i].y, g.x, g.y);
+    }
+    if (d == -1) return -1; // 机器人走不到的货物忽略
+    if (!good_alive_at(g.id, frame_id + d)) return -1; // 赶到时已过期的货物忽略
+    // 获取货物到最近泊位的真实距离
+    int dist_to_berth = berth_dist[g.x * N + g.y];
+    if (dist_to_berth == -1) return -1; // 无法到达泊位的货物忽略
+    return d + dist_to_berth;
+}
+
+// 从机器人 i 所在的桶环形向外搜索，返回评分 价值/(总距离+1) 最高的至多 k 个候选：
+// top 中每项为 (评分, 货物下标, 总距离)，按评分从高到低排列
+void ring_search_goods(int i, int k, vector<pair<double, pair<int, int>>>& top) {
+    typedef pair<double, pair<int, int>> Item;
+    top.clear();
+    if (k <= 0 || goods_list.empty()) return;
+    int br = robots[i].x / GOOD_BUCKET, bc = robots[i].y / GOOD_BUCKET;
+    int max_r = max(max(br, gb_rows - 1 - br), max(bc, gb_cols - 1 - bc));
+    int scanned = 0;  // 已扫描的货物数，扫完全部货物即可停止外扩
+    auto scan_range = [&](int t0, int t1) {
+        scanned += t1 - t0;
+        for (int t = t0; t < t1; t++) {
+            // 乐观评分已不超过堆顶时跳过精确计算
+            if ((int)top.size() == k && soa_score[t] <= top.front().first) continue;
+            int j = gb_items[t];
+            int total = good_total_dist(i, j);
+            if (total == -1) continue;
+            double score = (double)goods_list[j].val / (total + 1.0);
+            if ((int)top.size() < k) {
+                top.push_back({score, {j, total}});
+                push_heap(top.begin(), top.end(), greater<Item>());
+            } else if (score > top.front().first) {
+                pop_heap(top.begin(), top.end(), greater<Item>());
+                top.back() = {score, {j, total}};
+                push_heap(top.begin(), top.end(), greater<Item>());
+            }
+        }
+    };
+    // 货物不超过 k 个时堆永远不会满，环形剪枝不起作用，直接线性扫描全部货物（结果相同）
+    if ((int)goods_list.size() <= k) {
+        scan_range(0, goods_list.size());
+        sort(top.begin(), top.end(), greater<Item>());
+        return;
+    }
+    auto scan = [&](int b) {
+        if (gb_start[b] == gb_start[b + 1]) return;
+        score_goods(robots[i].x, robots[i].y, gb_start[b], gb_start[b + 1]);
+        scan_range(gb_start[b], gb_start[b + 1]);
+    };
+    for (int r = 0; r <= max_r && scanned < (int)goods_list.size(); r++) {
+        if ((int)top.size() == k) {
+            int lb = r == 0 ? 0 : (r - 1) * GOOD_BUCKET + 1;
+            if ((double)gb_vmax / (lb + gb_bdmin + 1.0) <= top.front().first) break;
+        }
+        for (int rr = br - r; rr <= br + r; rr++) {
+            if (rr < 0 || rr >= gb_rows) continue;
+            // 环的上下两行取整行，中间各行只取左右两端的桶
+            int step = (rr == br - r || rr == br + r) ? 1 : max(2 * r, 1);
+            for (int cc = bc - r; cc <= bc + r; cc += step) {
+                if (cc >= 0 && cc < gb_cols) scan(rr * gb_cols + cc);
+            }
+        }
+    }
+    sort(top.begin(), top.end(), greater<Item>());
+}
+
+// ========== 拍卖分配（Bertsekas auction） ==========
+// 空闲机器人为“买家”，货物为“物品”，收益 a_ij = 价值/(人货距离+货到泊位距离+1)，
+// 求收益总和最大的匹配（机器人也可以不分配，相当于收益为0的“放弃”选项）。
+// 每个未分配的机器人对净收益 a_ij - p_j 最高的货物出价，把价格抬到“次优净收益”能接受的程度再加 ε，
+// 原持有者被挤下后重新出价，直到无人可改进。收益量化为整数并乘以 (ROBOT_NUM+1)，取 ε=1 时结果即为最优匹配。
+// 热启动：价格记在货物登记表里跨帧保留，上一帧的分配若仍满足 ε-互补松弛则直接沿用，
+// 因此只有新出现的货物、新空闲的机器人以及受其影响的机器人需要出价。
+// 结束时未分配的货物价格必须为0（否则不是最优），热启动价格违反时清零并让受影响的机器人重新出价；
+// 修复轮数用尽则从零价格冷启动（零价格起步的正向拍卖总能得到最优解）。
+enum AssignMode { ASSIGN_GREEDY, ASSIGN_AUCTION };
+AssignMode assign_mode = ASSIGN_AUCTION;   // 命令行 --assign greedy|auction 切换
+
+const long long AUCTION_SCALE = 1 << 20;    // 收益量化精度
+const int AUCTION_REPAIR_ROUNDS = 4;        // 热启动价格修复的最大轮数
+const long long AUCTION_MAX_BIDS = 200000;  // 每帧出价次数上限，超出时保留当前（部分）分配
+vector<int> auction_prev_good;              // 每个机器人上一帧分配到的货物ID，-1表示无
+
+struct AuctionEdge {
+    int good;            // 货物在 goods_list 中的下标
+    long long benefit;   // 量化后的收益
+};
+
+// 把 价值/(总距离+1) 量化为拍卖使用的整数收益
+inline long long auction_benefit(int val, int total_dist) {
+    return (long long)val * AUCTION_SCALE / (total_dist + 1) * (ROBOT_NUM + 1);
+}
+
+// cand[i] 为机器人 i 的候选货物及收益（不可分配的机器人为空表），结果写入 robot_target_good
+void auction_assign(const vector<vector<AuctionEdge>>& cand, vector<int>& robot_target_good) {
+    if ((int)auction_prev_good.size() != ROBOT_NUM) auction_prev_good.assign(ROBOT_NUM, -1);
+
+    int G = goods_list.size();
+    vector<long long> price(G, 0);
+    vector<int> owner(G, -1);
+    vector<int> assigned(ROBOT_NUM, -1);     // 机器人当前持有的候选下标（cand[i] 中的位置）
+    long long bids = 0;
+
+    // 机器人 i 在当前价格下的最优净收益（含放弃选项0），best_k 返回对应候选下标
+    auto best_value = [&](int i, int& best_k, long long& second) {
+        long long v1 = 0;
+        second = 0;
+        best_k = -1;
+        for (int k = 0; k < (int)cand[i].size(); k++) {
+            long long v = cand[i][k].benefit - price[cand[i][k].good];
+            if (v > v1) {
+                second = v1;
+                v1 = v;
+                best_k = k;
+            } else if (v > second) {
+                second = v;
+            }
+        }
+        return v1;
+    };
+    // 机器人 i 是否满足 ε-互补松弛：当前净收益不低于最优净收益减 ε
+    auto satisfied = [&](int i) {
+        int best_k;
+        long long second;
+        long long best = best_value(i, best_k, second);
+        long long cur = assigned[i] == -1 ? 0 : cand[i][assigned[i]].benefit - price[cand[i][assigned[i]].good];
+        return cur >= best - 1;
+    };
+    auto run_bidding = [&](vector<int>& queue) {
+        while (!queue.empty() && bids < AUCTION_MAX_BIDS) {
+            // 到期则停止出价：当前分配仍是合法匹配，只是未必最优
+            if ((bids & 255) == 255 && frame_deadline_passed()) {
+                bids = AUCTION_MAX_BIDS;
+                break;
+            }
+            int i = queue.back();
+            queue.pop_back();
+            int k;
+            long long second;
+            long long v1 = best_value(i, k, second);
+            if (k == -1 || v1 <= 0) continue;   // 放弃：没有净收益为正的货物
+            int j = cand[i][k].good;
+            price[j] += v1 - second + 1;
+            if (owner[j] != -1) {
+                assigned[owner[j]] = -1;
+                queue.push_back(owner[j]);
+            }
+            owner[j] = i;
+            assigned[i] = k;
+            bids++;
+        }
+    };
+
+    // 热启动：沿用上一帧的价格与仍然有效的分配（新出现的货物价格为0）
+    for (int j = 0; j < G; j++) price[j] = good_records[goods_list[j].id].price;
+    for (int i = 0; i < ROBOT_NUM; i++) {
+        if (cand[i].empty() || auction_prev_good[i] == -1) continue;
+        for (int k = 0; k < (int)cand[i].size(); k++) {
+            if (goods_list[cand[i][k].good].id == auction_prev_good[i] && owner[cand[i][k].good] == -1) {
+                owner[cand[i][k].good] = i;
+                assigned[i] = k;
+                break;
+            }
+        }
+    }
+    vector<int> queue;
+    for (int i = 0; i < ROBOT_NUM; i++) {
+        if (cand[i].empty()) continue;
+        if (!satisfied(i)) {
+            if (assigned[i] != -1) owner[cand[i][assigned[i]].good] = -1;
+            assigned[i] = -1;
+            queue.push_back(i);
+        }
+    }
+    run_bidding(queue);
+
+    // 修复：未分配货物的价格清零，再让因此不满足互补松弛的机器人重新出价
+    bool optimal = false;
+    for (int round = 0; round < AUCTION_REPAIR_ROUNDS && bids < AUCTION_MAX_BIDS; round++) {
+        bool changed = false;
+        for (int j = 0; j < G; j++) {
+            if (owner[j] == -1 && price[j] > 0) {
+                price[j] = 0;
+                changed = true;
+            }
+        }
+        if (!changed) {
+            optimal = true;
+            break;
+        }
+        for (int i = 0; i < ROBOT_NUM; i++) {
+            if (cand[i].empty() || satisfied(i)) continue;
+            if (assigned[i] != -1) owner[cand[i][assigned[i]].good] = -1;
+            assigned[i] = -1;
+            queue.push_back(i);
+        }
+        run_bidding(queue);
+    }
+    if (!optimal && bids < AUCTION_MAX_BIDS) {
+        // 冷启动：所有价格从0开始重新拍卖
+        fill(price.begin(), price.end(), 0);
+        fill(owner.begin(), owner.end(), -1);
+        fill(assigned.begin(), assigned.end(), -1);
+        queue.clear();
+        for (int i = 0; i < ROBOT_NUM; i++) {
+            if (!cand[i].empty()) queue.push_back(i);
+        }
+        run_bidding(queue);
+    }
+
+    // 输出分配，并保存价格与分配供下一帧热启动
+    for (int j = 0; j < G; j++) good_records[goods_list[j].id].price = price[j];
+    for (int i = 0; i < ROBOT_NUM; i++) {
+        robot_target_good[i] = assigned[i] == -1 ? -1 : cand[i][assigned[i]].good;
+        auction_prev_good[i] = assigned[i] == -1 ? -1 : goods_list[robot_target_good[i]].id;
+    }
+}
+
+// 解析命令行参数
+void parse_args(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--planner" && i + 1 < argc) {
+            string name = argv[++i];
+            if (name == "bfs") planner_mode = PLANNER_BFS;
+            else if (name == "astar") planner_mode = PLANNER_ASTAR;
+            else if (name == "jps") planner_mode = PLANNER_JPS;
+            else if (name == "hpa") planner_mode = PLANNER_HPA;
+            else if (name == "dstar") planner_mode = PLANNER_DSTAR;
+            else cerr << "未知的寻路算法: " << name << endl;
+        } else if (arg == "--coop" && i + 1 < argc) {
+            coop_window = max(0, min(COOP_MAX_WINDOW, atoi(argv[++i])));
+        } else if (arg == "--cbs" && i + 1 < argc) {
+            cbs_threshold = max(0, atoi(argv[++i]));
+        } else if (arg == "--assign" && i + 1 < argc) {
+            string name = argv[++i];
+            if (name == "greedy") assign_mode = ASSIGN_GREEDY;
+            else if (name == "auction") assign_mode = ASSIGN_AUCTION;
+            else cerr << "未知的分配算法: " << name << endl;
+        } else if (arg == "--budget" && i + 1 < argc) {
+            frame_budget_ms = atof(argv[++i]);
+        } else if (arg == "--simd" && i + 1 < argc) {
+            string name = argv[++i];
+            if (name == "scalar") simd_mode = SIMD_SCALAR;
+            else if (name == "sse2") simd_mode = SIMD_SSE2;
+            else if (name == "avx2") simd_mode = SIMD_AVX2;
+            else cerr << "未知的指令集: " << name << endl;
+        } else if (arg == "--shm" && i + 3 < argc) {
+            shm_name = argv[++i];
+            shm_in_fd = atoi(argv[++i]);
+            shm_out_fd = atoi(argv[++i]);
+        } else if (arg == "--iostream") {
+            io_iostream = true;
+        } else if (arg == "--map" && i + 1 < argc) {
+            map_path = argv[++i];
+        } else if (arg == "--rows" && i + 1 < argc) {
+            arg_rows = atoi(argv[++i]);
+        } else if (arg == "--cols" && i + 1 < argc) {
+            arg_cols = atoi(argv[++i]);
+        } else if (arg == "--robots" && i + 1 < argc) {
+            arg_robots = atoi(argv[++i]);
+        } else if (arg == "--ships" && i + 1 < argc) {
+            arg_ships = atoi(argv[++i]);
+        }
+    }
+}
+
+// 加载地图并初始化所有预计算结构与跨帧状态；重复调用即开始一局新的游戏（模拟器据此在进程内连续跑多局）
+void solver_init() {
+    setup_start = chrono::steady_clock::now();
+    // 加载地图数据（同时确定地图尺寸与舰队规模）
+    load_map();
+    init_search_tables(); // 按尺寸分配寻路工作区与时空表
+    init_berth_dist(); // 预计算最近泊位距离场与方向表
+    if (planner_mode == PLANNER_HPA) init_hpa(); // 只有选用分层寻路时才构建簇与抽象图
+    init_landmarks();  // 选取地标并计算地标距离表
+    init_berth_fields(); // 启动预算内计算各泊位距离场
+    init_good_fields(); // 分配货物距离场缓存
+    init_score_kernel(); // 按 CPU 支持情况选择货物评分核
+
+    // 清空跨帧保留的状态
+    goods_list.clear();
+    occupied_list.clear();
+    good_records.clear();
+    good_id_at.assign(CELL_COUNT, -1);
+    goods_alive.clear();
+    auction_prev_good.assign(ROBOT_NUM, -1);
+    coop_path_valid = false;
+    good_field_pending.clear();
+    degraded_frames = 0;
+    overrun_frames = 0;
+    max_frame_ms = 0;
+    frame_cmds.clear();
+    out_buf.clear();
+}
+
+// 决策一帧：帧数据（frame_id、money、goods_list、robots、ships）已就绪，
+// 指令经 out_cmd 写入 out_buf 与 frame_cmds，由调用方输出或直接执行
+void solve_frame() {
+    frame_timer_start();
+    // 更新货物登记表（稳定ID与出现/消失事件），再据此维护货物距离场缓存
+    update_goods_registry();
+    update_good_fields();
+
+    // 初始化占用地图，标记当前所有机器人的位置
+    // 上一帧标记过的格子都在 occupied_list 中，只清除这些格子的占用位
+    for (int c : occupied_list) release_occupied(c / N, c % N);
+    occupied_list.clear();
+    for(int i=0; i<ROBOT_NUM; i++) {
+        mark_occupied(robots[i].x, robots[i].y);
+    }
+    if (coop_window > 0) coop_begin_frame();
+
+    // ========== 货物的全局分配阶段 ==========
+    // 默认用拍卖算法求最优匹配（见“拍卖分配”），--assign greedy 时按评分贪心分配
+    vector<int> robot_target_good(ROBOT_NUM, -1);  // 记录每个机器人的目标货物索引，-1表示无目标
+    vector<bool> good_assigned(goods_list.size(), false);  // 记录货物是否已被分配
+    vector<Candidate> candidates;  // 候选分配列表（贪心）
+    vector<vector<AuctionEdge>> robot_cands(ROBOT_NUM);  // 每个机器人的候选列表（拍卖）
+
+    // 为每个空闲且未携带货物的机器人生成候选：在货物分桶上环形搜索评分最高的 ROBOT_NUM 个
+    build_good_buckets();
+    build_goods_soa();
+    vector<pair<double, pair<int, int>>> top;
+    for (int i = 0; i < ROBOT_NUM; i++) {
+        // 跳过不可用的机器人和已携带货物的机器人
+        if (robots[i].status == 0 || robots[i].has_goods) continue;
+
+        // 到期后剩余机器人不再生成候选，本帧保持空闲
+        if (frame_deadline_passed()) break;
+        ring_search_goods(i, ROBOT_NUM, top);
+        for (const auto& t : top) {
+            int j = t.second.first;
+            // 评分：货物价值 / (人货距离 + 货到泊位距离 + 1)
+            if (assign_mode == ASSIGN_AUCTION) {
+                robot_cands[i].push_back({j, auction_benefit(goods_list[j].val, t.second.second)});
+            } else {
+                candidates.push_back({i, j, t.first});
+            }
+        }
+    }
+
+    if (assign_mode == ASSIGN_AUCTION) {
+        auction_assign(robot_cands, robot_target_good);
+    } else {
+        // 按评分降序排序（评分高的优先分配）
+        sort(candidates.begin(), candidates.end());
+
+        // 贪心分配：按评分从高到低依次分配
+        // 确保每个机器人只分配一个货物，每个货物只分配给一个机器人
+        for (const auto& cand : candidates) {
+            if (robot_target_good[cand.robot_id] == -1 && !good_assigned[cand.good_idx]) {
+                robot_target_good[cand.robot_id] = cand.good_idx;
+                good_assigned[cand.good_idx] = true;
+            }
+        }
+    }
+
+    // ========== 优先级计算与排序 ==========
+    // 根据货物价值分配优先级，携带货物的优先级最高
+    vector<int> robot_priority(ROBOT_NUM, 0);
+    vector<int> p_order(ROBOT_NUM);
+    for (int i = 0; i < ROBOT_NUM; i++) {
+        p_order[i] = i;
+        if (robots[i].has_goods) {
+            robot_priority[i] = 10000; // 携带货物的优先级最高
+        } else if (robot_target_good[i] != -1) {
+            robot_priority[i] = goods_list[robot_target_good[i]].val;
+        } else {
+            robot_priority[i] = 0;
+        }
+    }
+    // 按优先级降序排序，优先级高的机器人先行动
+    sort(p_order.begin(), p_order.end(), [&](int a, int b){
+        return robot_priority[a] > robot_priority[b];
+    });
+
+    // ========== 拥堵区 CBS 规划 ==========
+    // 先确定每个需要移动的机器人的目标格子和距离场，再对拥堵区整体求解；目标距离场本帧放不下的机器人不参与
+    vector<int> goal_cell(ROBOT_NUM, -1);
+    vector<const int*> goal_field(ROBOT_NUM, nullptr);
+    for (int i = 0; i < ROBOT_NUM; i++) {
+        if (robots[i].status == 0) continue;
+        int here = robots[i].x * N + robots[i].y;
+        if (robots[i].has_goods) {
+            int b = nearest_berth[robots[i].x * N + robots[i].y];
+            if (b == -1 || berths[b].first * N + berths[b].second == here) continue;
+            goal_field[i] = get_berth_field(b);
+            if (goal_field[i]) goal_cell[i] = berths[b].first * N + berths[b].second;
+        } else if (robot_target_good[i] != -1) {
+            const Goods& g = goods_list[robot_target_good[i]];
+            if (g.x * N + g.y == here) continue;
+            goal_field[i] = get_good_field(g.x, g.y);
+            if (goal_field[i]) goal_cell[i] = g.x * N + g.y;
+        }
+    }
+    cbs_plan_frame(goal_cell, goal_field);
+
+    // ========== 机器人处理阶段 ==========
+    for (int k = 0; k < ROBOT_NUM; k++) {
+        int i = p_order[k]; // 按优先级顺序处理机器人
+
+        // 跳过不可用的机器人
+        if (robots[i].status == 0) continue; 
+
+        // 更新卡死状态检测
+        // 如果机器人位置与上一帧相同，说明可能卡住了
+        if (robots[i].x == robots[i].last_x && robots[i].y == robots[i].last_y) {
+            robots[i].stuck_count++;  // 增加卡住计数
+        } else {
+            robots[i].stuck_count = 0;  // 重置卡住计数
+        }
+        // 更新上一帧位置
+        robots[i].last_x = robots[i].x;
+        robots[i].last_y = robots[i].y;
+
+        // 临时释放当前位置，用于路径规划
+        // 这样机器人可以规划从当前位置出发的路径
+        release_occupied(robots[i].x, robots[i].y);
+
+        int move_dir = -1;  // 移动方向，-1表示不移动
+        bool action_taken = false;  // 是否执行了动作（get或pull）
+        bool cheap = frame_deadline_passed();  // 已到期限：只用查表/梯度下降的廉价动作
+        int tx = -1, ty = -1; // 目标坐标，用于防卡死时的启发式选择
+
+        if (robots[i].has_goods) {
+            // ========== 携带货物状态：前往最近的泊位 ==========
+            // 按真实行走距离查表得到最近泊位
+            int b = nearest_berth[robots[i].x * N + robots[i].y];
+
+            if (b != -1) {
+                tx = berths[b].first; ty = berths[b].second; // 记录目标
+                // 如果已经在泊位位置，执行pull操作（将货物放到船上）
+                if (robots[i].x == tx && robots[i].y == ty) {
+                    out_cmd(CMD_PULL, i);
+                    action_taken = true;
+                } else {
+                    // 否则直接查方向表；最短路方向全被占用时才退回寻路绕行
+                    // 开启协作规划时改为在时空预约表上规划；已由 CBS 决定的机器人不再规划
+                    // 该泊位的距离场（规划所需的启发）本帧放不下时只查方向表
+                    const int* field = cheap ? peek_berth_field(b) : get_berth_field(b);
+                    if (cbs_assigned[i]) {
+                        move_dir = cbs_move[i];
+                    } else if (coop_window > 0 && !cheap && field) {
+                        move_dir = coop_step(i, tx, ty, field);
+                    } else {
+                        move_dir = berth_step(b, robots[i].x, robots[i].y);
+                    }
+                    if (move_dir == -1 && coop_window == 0 && !cbs_assigned[i] && !cheap && field) {
+                        move_dir = plan_step(i, robots[i].x, robots[i].y, tx, ty, field);
+                    }
+                }
+            }
+        } else {
+            // ========== 未携带货物状态：前往预分配的目标货物 ==========
+            int target_idx = robot_target_good[i];
+            if (target_idx != -1) {
+                tx = goods_list[target_idx].x; ty = goods_list[target_idx].y; // 记录目标
+                // 如果已经在货物位置，执行get操作（捡起货物）
+                if (robots[i].x == goods_list[target_idx].x && robots[i].y == goods_list[target_idx].y) {
+                    out_cmd(CMD_GET, i);
+                    action_taken = true;
+                } else {
+                    // 否则沿货物距离场梯度下降；下降方向全被占用时才退回寻路，并以该距离场为启发
+                    // 到期时只使用已缓存的距离场，不再触发新的计算；没有距离场时按地标下界走一步
+                    const int* field = cheap ? peek_good_field(tx, ty) : get_good_field(tx, ty);
+                    if (cbs_assigned[i]) {
+                        move_dir = cbs_move[i];
+                    } else if (!field) {
+                        move_dir = lower_bound_step(robots[i].x, robots[i].y, tx, ty);
+                    } else if (coop_window > 0 && !cheap) {
+                        move_dir = coop_step(i, tx, ty, field);
+                    } else {
+                        move_dir = descend_step(field, robots[i].x, robots[i].y);
+                    }
+                    if (move_dir == -1 && coop_window == 0 && !cbs_assigned[i] && !cheap && field) {
+                        move_dir = plan_step(i, robots[i].x, robots[i].y, tx, ty, field);
+                    }
+                }
+            }
+        }
+
+        // ========== 处理移动 ==========
+        int final_cell = robots[i].x * N + robots[i].y;  // 本帧结束时所在格子
+        if (!action_taken) {
+            int final_move_dir = -1;
+
+            // 0. CBS 已为拥堵区求出无冲突的动作，其下一步格子已预先占用，直接执行
+            if (cbs_assigned[i]) {
+                final_move_dir = move_dir;
+                for (int t = 0; t <= coop_window; t++) {
+                    coop_path[t] = cbs_paths[i][min(t, CBS_HORIZON)];
+                }
+                coop_path_valid = true;
+            }
+
+            // 1. 尝试最优路径
+            if (move_dir != -1 && !cbs_assigned[i]) {
+                int nx = robots[i].x + dx[move_dir];
+                int ny = robots[i].y + dy[move_dir];
+                // 检查是否被占用
+                if (!occupied_at(nx, ny)) {
+                    final_move_dir = move_dir;
+                }
+            }
+
+            // 2. 防卡死机制：如果最优路径被阻挡 或 无路径，且已卡住一段时间
+            // 阈值设为2，意味着如果连续2帧没动，就开始尝试绕路
+            if (final_move_dir == -1 && robots[i].stuck_count > 2 && !cbs_assigned[i]) {
+                vector<int> alt_dirs;
+                for (int d = 0; d < 4; d++) {
+                    if (d == move_dir) continue; // 跳过原本想走但走不通的方向
+                    
+                    int nx = robots[i].x + dx[d];
+                    int ny = robots[i].y + dy[d];
+
+                    // 检查合法性：越界、障碍物、被占用在扁平网格上都是非零标记
+                    if (!cell_flags[pad_of(nx, ny)]) {
+                        alt_dirs.push_back(d);
+                    }
+                }
+
+                if (!alt_dirs.empty()) {
+                    // 如果有明确目标，按曼哈顿距离排序，优先选择离目标近的
+                    if (tx != -1) {
+                        sort(alt_dirs.begin(), alt_dirs.end(), [&](int a, int b){
+                            int da = abs(robots[i].x + dx[a] - tx) + abs(robots[i].y + dy[a] - ty);
+                            int db = abs(robots[i].x + dx[b] - tx) + abs(robots[i].y + dy[b] - ty);
+                            return da < db;
+                        });
+                    }
+                    final_move_dir = alt_dirs[0];
+                }
+            }
+
+            if (final_move_dir != -1) {
+                out_cmd(CMD_MOVE, i, final_move_dir);
+                int nx = robots[i].x + dx[final_move_dir];
+                int ny = robots[i].y + dy[final_move_dir];
+                mark_occupied(nx, ny);
+                final_cell = nx * N + ny;
+            } else {
+                mark_occupied(robots[i].x, robots[i].y); // 保持原地
+            }
+        } else {
+            // 执行了get或pull动作，机器人保持原地不动
+            mark_occupied(robots[i].x, robots[i].y);
+        }
+
+        // 把本帧动作及之后的规划路径写入时空预约表，供后续机器人避让
+        if (coop_window > 0) coop_commit(i, final_cell);
+    }
+
+    // ========== 船只处理阶段 ==========
+    // 简单策略：让所有船只都执行go命令（离开泊位）
+    for (int i = 0; i < SHIP_NUM; i++) {
+        out_cmd(CMD_GO, i);
+    }
+}
+
+#ifndef PORT_SOLVER_NO_MAIN
+int main(int argc, char* argv[]) {
+    parse_args(argc, argv);
+#ifdef _WIN32
+    // 二进制协议需要原样收发字节，关闭 Windows 标准流的换行转换
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    if (!shm_name.empty()) {
+        io_shm = shm_open_transport();
+        if (!io_shm) {
+            cerr << "无法打开共享内存 " << shm_name << endl;
+            return 1;
+        }
+        io_iostream = false;
+    }
+
+    solver_init();
+
+    negotiate_protocol(); // 判题器要求时切换到二进制协议
+    // 主循环：处理每一帧的游戏数据
+    while (read_frame_data()) {
+        solve_frame();
         // 输出帧结束标志，表示本帧的所有指令已输出完毕
-        cout << "OK" << endl;
+        out_flush_frame();
+        frame_timer_finish();
     }
+    cerr << "降级帧数: " << degraded_frames << "，超时帧数: " << overrun_frames
+         << "，单帧最长耗时: " << max_frame_ms << " ms" << endl;
     return 0;
 }
+#endif
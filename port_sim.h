@@ -0,0 +1,319 @@
+// 港口模拟器：在 C++ 中逐条复现 judge.py 的 GameState 与每帧结算规则，
+// 供 sim_main.cpp 在进程内直接驱动决策程序（不经过子进程和管道），用于大批量评测。
+//
+// 与 judge.py 保持一致的细节：
+//   随机数：Python 的 random 模块（MT19937，random.seed(整数) 即 init_by_array，
+//           random() 由两次 32 位输出拼成 53 位，randint 经 getrandbits 拒绝采样），调用顺序与判题器相同；
+//   货物：按插入顺序保存（对应 Python 字典），被取走后同一格再刷出的货物排到末尾；
+//   移动：先按指令顺序收集 next_pos（同一机器人的后一条有效移动覆盖前一条，但保留首次出现的位置），
+//         再按该顺序对照 current_occupied（按格子去重的集合）逐个结算；
+//   判题器中会抛出异常的情况（编号越界、从集合中移除不存在的格子）记为运行错误并结束游戏。
+#ifndef PORT_SIM_H
+#define PORT_SIM_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace port_sim {
+
+// Python random 模块的 Mersenne Twister
+class PyRandom {
+public:
+    explicit PyRandom(long long seed = 0) { seed_int(seed); }
+
+    // random.seed(整数)：按 |seed| 的 32 位小端分段作为 init_by_array 的密钥
+    void seed_int(long long seed) {
+        unsigned long long a = seed < 0 ? 0ULL - (unsigned long long)seed : (unsigned long long)seed;
+        std::vector<uint32_t> key;
+        while (a) {
+            key.push_back((uint32_t)(a & 0xFFFFFFFFu));
+            a >>= 32;
+        }
+        if (key.empty()) key.push_back(0);
+        init_by_array(key);
+    }
+
+    uint32_t genrand_uint32() {
+        static const uint32_t mag01[2] = {0u, 0x9908b0dfu};
+        if (mti >= MT_N) {
+            int kk;
+            for (kk = 0; kk < MT_N - MT_M; kk++) {
+                uint32_t y = (mt[kk] & 0x80000000u) | (mt[kk + 1] & 0x7fffffffu);
+                mt[kk] = mt[kk + MT_M] ^ (y >> 1) ^ mag01[y & 1];
+            }
+            for (; kk < MT_N - 1; kk++) {
+                uint32_t y = (mt[kk] & 0x80000000u) | (mt[kk + 1] & 0x7fffffffu);
+                mt[kk] = mt[kk + (MT_M - MT_N)] ^ (y >> 1) ^ mag01[y & 1];
+            }
+            uint32_t y = (mt[MT_N - 1] & 0x80000000u) | (mt[0] & 0x7fffffffu);
+            mt[MT_N - 1] = mt[MT_M - 1] ^ (y >> 1) ^ mag01[y & 1];
+            mti = 0;
+        }
+        uint32_t y = mt[mti++];
+        y ^= (y >> 11);
+        y ^= (y << 7) & 0x9d2c5680u;
+        y ^= (y << 15) & 0xefc60000u;
+        y ^= (y >> 18);
+        return y;
+    }
+
+    // random.random()：[0, 1) 上的 53 位精度浮点数
+    double random() {
+        uint32_t a = genrand_uint32() >> 5, b = genrand_uint32() >> 6;
+        return (a * 67108864.0 + b) * (1.0 / 9007199254740992.0);
+    }
+
+    // random.getrandbits(k)，1 <= k <= 32
+    uint32_t getrandbits(int k) { return genrand_uint32() >> (32 - k); }
+
+    // random.randint(a, b)：a + _randbelow(b - a + 1)，按位数取随机数并拒绝越界值
+    int randint(int a, int b) {
+        uint32_t n = (uint32_t)(b - a + 1);
+        int k = 0;
+        while ((n >> k) != 0) k++;  // n.bit_length()
+        uint32_t r = getrandbits(k);
+        while (r >= n) r = getrandbits(k);
+        return a + (int)r;
+    }
+
+private:
+    static const int MT_N = 624, MT_M = 397;
+    uint32_t mt[MT_N];
+    int mti = MT_N + 1;
+
+    void init_genrand(uint32_t s) {
+        mt[0] = s;
+        for (mti = 1; mti < MT_N; mti++) {
+            mt[mti] = 1812433253u * (mt[mti - 1] ^ (mt[mti - 1] >> 30)) + (uint32_t)mti;
+        }
+    }
+
+    void init_by_array(const std::vector<uint32_t>& key) {
+        init_genrand(19650218u);
+        int i = 1, j = 0, len = (int)key.size();
+        for (int k = MT_N > len ? MT_N : len; k; k--) {
+            mt[i] = (mt[i] ^ ((mt[i - 1] ^ (mt[i - 1] >> 30)) * 1664525u)) + key[j] + (uint32_t)j;
+            i++;
+            j++;
+            if (i >= MT_N) {
+                mt[0] = mt[MT_N - 1];
+                i = 1;
+            }
+            if (j >= len) j = 0;
+        }
+        for (int k = MT_N - 1; k; k--) {
+            mt[i] = (mt[i] ^ ((mt[i - 1] ^ (mt[i - 1] >> 30)) * 1566083941u)) - (uint32_t)i;
+            i++;
+            if (i >= MT_N) {
+                mt[0] = mt[MT_N - 1];
+                i = 1;
+            }
+        }
+        mt[0] = 0x80000000u;
+    }
+};
+
+// 读取地图，与 judge.py 的 load_map_file 相同：首行以数字开头时为头部 "行数 列数 [机器人数 船数]"
+inline bool load_map_file(const std::string& path, std::vector<std::string>& rows, std::vector<int>& header) {
+    std::ifstream in(path);
+    if (!in) return false;
+    rows.clear();
+    header.clear();
+    std::string line;
+    bool first = true;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (first && !line.empty() && line[0] >= '0' && line[0] <= '9') {
+            const char* p = line.c_str();
+            char* end;
+            for (long v = strtol(p, &end, 10); end != p; v = strtol(p, &end, 10)) {
+                header.push_back((int)v);
+                p = end;
+            }
+        } else if (!line.empty()) {
+            rows.push_back(line);
+        }
+        first = false;
+    }
+    return true;
+}
+
+// 指令操作码，与 main.cpp 的 CmdOp 相同
+enum Op { OP_MOVE = 1, OP_GET = 2, OP_PULL = 3, OP_GO = 4 };
+
+// 一局游戏的状态与结算规则（对应 judge.py 的 GameState 和 run_game 中的逐帧处理）
+class PortGame {
+public:
+    static const int GOODS_CAP = 50;        // 场上货物数达到该值后不再刷新
+    static const int GOOD_LIFETIME = 1000;  // 货物存活帧数
+
+    struct Good {
+        int x, y, val, expire;
+        bool alive;
+    };
+    struct Robot {
+        int x, y, goods, status;
+    };
+
+    int rows, cols;
+    int frame = 1;
+    long long money = 0;
+    bool error = false;                  // 是否发生了判题器中会抛出异常的运行错误
+    std::vector<Robot> robots;
+    std::vector<long long> ship_capacity;
+
+    PortGame(const std::vector<std::string>& map_rows, int rows_, int cols_, int robot_count, int ship_count,
+             long long seed)
+        : rows(rows_), cols(cols_), rng(seed), map(map_rows) {
+        ship_capacity.assign(ship_count, 0);
+        good_at.assign((size_t)rows * cols, -1);
+        occupied.assign((size_t)rows * cols, 0);
+        std::vector<std::pair<int, int>> starts;
+        for (int r = 0; r < rows; r++) {
+            for (int c = 0; c < cols; c++) {
+                if (at(r, c) == 'A') starts.push_back(std::make_pair(r, c));
+            }
+        }
+        while ((int)starts.size() < robot_count) starts.push_back(std::make_pair(0, 0));
+        for (int i = 0; i < robot_count; i++) robots.push_back({starts[i].first, starts[i].second, 0, 1});
+        next_cell.assign(robot_count, -1);
+    }
+
+    char at(int x, int y) const { return y < (int)map[x].size() ? map[x][y] : '\0'; }
+
+    // 对应 GameState.step_goods：按概率刷新一个货物，再删除过期货物
+    void step_goods() {
+        if (alive_count < GOODS_CAP && rng.random() < 0.2) {
+            int x = rng.randint(0, rows - 1), y = rng.randint(0, cols - 1);
+            if (at(x, y) == '.' && good_at[x * cols + y] == -1) {
+                int val = rng.randint(10, 100);
+                good_at[x * cols + y] = (int)goods.size();
+                goods.push_back({x, y, val, frame + GOOD_LIFETIME, true});
+                alive_count++;
+            }
+        }
+        for (auto& g : goods) {
+            if (g.alive && g.expire <= frame) remove_good(g);
+        }
+        compact_goods();
+    }
+
+    // 按插入顺序遍历在场货物
+    template <class F>
+    void for_each_good(F f) const {
+        for (const auto& g : goods) {
+            if (g.alive) f(g);
+        }
+    }
+    int goods_count() const { return alive_count; }
+
+    // 结算一帧的指令（C 为带 op、id、arg 字段的指令类型）；发生运行错误时返回 false
+    template <class C>
+    bool apply(const std::vector<C>& cmds) {
+        int robot_count = (int)robots.size();
+        // 1. 收集移动意图
+        move_order.clear();
+        for (const auto& cmd : cmds) {
+            if (cmd.op != OP_MOVE) continue;
+            if (cmd.id < 0 || cmd.id >= robot_count) return fail();
+            static const int ddx[4] = {0, 0, -1, 1}, ddy[4] = {1, -1, 0, 0};
+            const Robot& r = robots[cmd.id];
+            int nx = r.x, ny = r.y;
+            if (cmd.arg >= 0 && cmd.arg < 4) {
+                nx += ddx[cmd.arg];
+                ny += ddy[cmd.arg];
+            }
+            if (nx >= 0 && nx < rows && ny >= 0 && ny < cols && at(nx, ny) != '#' && at(nx, ny) != '*') {
+                if (next_cell[cmd.id] == -1) move_order.push_back(cmd.id);
+                next_cell[cmd.id] = nx * cols + ny;
+            }
+        }
+        // 2. 对照本帧开始时的占用集合依次结算
+        for (const auto& r : robots) occupied[r.x * cols + r.y] = 1;
+        bool ok = true;
+        for (int rid : move_order) {
+            int to = next_cell[rid];
+            next_cell[rid] = -1;
+            if (!ok || occupied[to]) continue;
+            Robot& r = robots[rid];
+            int from = r.x * cols + r.y;
+            if (!occupied[from]) {
+                ok = false;  // Python 中 set.remove 抛出 KeyError
+                continue;
+            }
+            occupied[from] = 0;
+            r.x = to / cols;
+            r.y = to % cols;
+            occupied[to] = 1;
+        }
+        for (const auto& r : robots) occupied[r.x * cols + r.y] = 0;
+        if (!ok) return fail();
+        // 3. 按顺序处理 get / pull / go
+        for (const auto& cmd : cmds) {
+            if (cmd.op == OP_GET || cmd.op == OP_PULL) {
+                if (cmd.id < 0 || cmd.id >= robot_count) return fail();
+                Robot& r = robots[cmd.id];
+                if (cmd.op == OP_GET) {
+                    int idx = good_at[r.x * cols + r.y];
+                    if (r.goods == 0 && idx != -1) {
+                        r.goods = goods[idx].val;
+                        remove_good(goods[idx]);
+                    }
+                } else if (r.goods > 0 && at(r.x, r.y) == 'B') {
+                    ship_capacity[0] += r.goods;
+                    r.goods = 0;
+                }
+            } else if (cmd.op == OP_GO) {
+                if (cmd.id < 0 || cmd.id >= (int)ship_capacity.size()) return fail();
+                money += ship_capacity[cmd.id];
+                ship_capacity[cmd.id] = 0;
+            }
+        }
+        compact_goods();
+        return true;
+    }
+
+private:
+    PyRandom rng;
+    std::vector<std::string> map;
+    std::vector<Good> goods;        // 按插入顺序，已删除的项在 compact_goods 时移除
+    std::vector<int> good_at;       // 格子 -> goods 中的下标，-1表示没有货物
+    std::vector<char> occupied;     // 结算移动时的占用集合（结算完即清零）
+    std::vector<int> next_cell;     // 机器人 -> 本帧移动目标格子，-1表示没有
+    std::vector<int> move_order;    // next_pos 的插入顺序
+    int alive_count = 0;
+    int dead_count = 0;
+
+    void remove_good(Good& g) {
+        g.alive = false;
+        good_at[g.x * cols + g.y] = -1;
+        alive_count--;
+        dead_count++;
+    }
+
+    // 已删除的项超过一半时压缩，保持插入顺序并更新 good_at
+    void compact_goods() {
+        if (dead_count * 2 <= (int)goods.size()) return;
+        size_t w = 0;
+        for (size_t i = 0; i < goods.size(); i++) {
+            if (!goods[i].alive) continue;
+            goods[w] = goods[i];
+            good_at[goods[w].x * cols + goods[w].y] = (int)w;
+            w++;
+        }
+        goods.resize(w);
+        dead_count = 0;
+    }
+
+    bool fail() {
+        error = true;
+        return false;
+    }
+};
+
+}  // namespace port_sim
+
+#endif
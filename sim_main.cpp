@@ -0,0 +1,96 @@
+// 无界面快进评测：在同一进程内用 port_sim.h 的模拟器驱动 main.cpp 的决策，不经过判题器和管道。
+// 编译：g++ sim_main.cpp -o sim -O2 -std=c++11
+// 用法：./sim [--frames F] [main.cpp 的参数...] 种子1 种子2 ...
+//   地图与规模参数（--map / --robots / --ships 等）同时作用于模拟器与决策程序，结果与
+//   python judge.py ./main 种子 [同样的参数] 一致；每个种子输出一行 "Seed s: Final Score: x"。
+#define PORT_SOLVER_NO_MAIN
+#include "main.cpp"
+#include "port_sim.h"
+
+// 把模拟器的状态作为一帧输入交给决策程序（对应判题器 get_input_str 与 read_frame_data）
+void load_sim_frame(const port_sim::PortGame& game) {
+    frame_id = game.frame;
+    money = (int)game.money;
+    goods_list.clear();
+    game.for_each_good([](const port_sim::PortGame::Good& g) {
+        Goods item;
+        item.x = g.x;
+        item.y = g.y;
+        item.val = g.val;
+        item.comp = comp_id[g.x * N + g.y];
+        item.id = -1;
+        goods_list.push_back(item);
+    });
+    for (int i = 0; i < ROBOT_NUM; i++) {
+        const port_sim::PortGame::Robot& r = game.robots[i];
+        robots[i].has_goods = r.goods > 0 ? 1 : 0;
+        robots[i].x = r.x;
+        robots[i].y = r.y;
+        robots[i].status = r.status;
+        robots[i].comp = comp_id[r.x * N + r.y];
+    }
+    for (int i = 0; i < SHIP_NUM; i++) {
+        ships[i].status = 1;
+        ships[i].berth_id = i;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int max_frames = 1000;  // 与 judge.py 的 MAX_FRAMES 相同
+    vector<long long> seeds;
+    vector<char*> solver_argv(1, argv[0]);
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--frames" && i + 1 < argc) {
+            max_frames = atoi(argv[++i]);
+        } else if (arg.compare(0, 2, "--") == 0) {
+            // 其余选项原样交给决策程序；除 --iostream 外都带一个参数值
+            solver_argv.push_back(argv[i]);
+            if (arg != "--iostream" && i + 1 < argc) solver_argv.push_back(argv[++i]);
+        } else {
+            seeds.push_back(atoll(argv[i]));
+        }
+    }
+    if (seeds.empty()) seeds.push_back(42);  // 与判题器的默认种子相同
+    parse_args((int)solver_argv.size(), solver_argv.data());
+    io_capture = true;
+    frame_report = false;
+
+    vector<string> map_rows;
+    vector<int> header;
+    if (!port_sim::load_map_file(map_path, map_rows, header)) {
+        cerr << "地图加载失败: " << map_path << endl;
+        return 1;
+    }
+    double sim_ms = 0, solve_ms = 0;
+    long long frames_run = 0;
+    for (long long seed : seeds) {
+        solver_init();  // 每局重新初始化，尺寸与规模的解析规则与判题器相同
+        port_sim::PortGame game(map_rows, MAP_ROWS, N, ROBOT_NUM, SHIP_NUM, seed);
+        for (int frame = 1; frame <= max_frames; frame++) {
+            auto t0 = chrono::steady_clock::now();
+            game.frame = frame;
+            game.step_goods();
+            load_sim_frame(game);
+            auto t1 = chrono::steady_clock::now();
+            frame_cmds.clear();
+            solve_frame();
+            frame_timer_finish();
+            auto t2 = chrono::steady_clock::now();
+            bool ok = game.apply(frame_cmds);
+            auto t3 = chrono::steady_clock::now();
+            sim_ms += chrono::duration<double, milli>((t1 - t0) + (t3 - t2)).count();
+            solve_ms += chrono::duration<double, milli>(t2 - t1).count();
+            frames_run++;
+            if (!ok) {
+                cout << "Seed " << seed << ": Runtime Error at frame " << frame << endl;
+                break;
+            }
+        }
+        cout << "Seed " << seed << ": Berths: " << berths.size() << endl;
+        cout << "Seed " << seed << ": Final Score: " << game.money << endl;
+    }
+    cerr << "帧数 " << frames_run << "，模拟耗时 " << sim_ms << " ms（" << (sim_ms > 0 ? frames_run / sim_ms : 0)
+         << " 帧/ms），决策耗时 " << solve_ms << " ms" << endl;
+    return 0;
+}
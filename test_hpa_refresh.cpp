@@ -0,0 +1,102 @@
+// 分层寻路局部刷新检查：翻转某个簇内一个格子的墙标记，只调用 hpa_refresh_cluster() 刷新该簇，
+// 再与 init_hpa() 全量重建后的结果对比，要求大量起终点对上 hpa_plan 给出的第一步完全一致。
+// 编译：g++ test_hpa_refresh.cpp -o test_hpa_refresh -O2 -std=c++11
+// 用法：./test_hpa_refresh [--trials T] [--pairs P] [main.cpp 的参数...]
+//   全部一致时输出 "OK" 并返回0；出现不一致时打印第一处差异并返回1。
+#define PORT_SOLVER_NO_MAIN
+#include "main.cpp"
+#include <random>
+
+// 翻转(x,y)的墙标记后重建结点图，工作区按新的结点数重新分配（抽象层数据按格子编号索引，不受结点重编号影响）
+void toggle_wall(int x, int y) {
+    cell_flags[pad_of(x, y)] ^= CELL_WALL;
+    build_graph();
+    search_ws.init(node_count);
+}
+
+// 依次对每个起终点对调用 hpa_plan，记录第一步方向
+vector<int> plan_steps(const vector<pair<int, int>>& pairs) {
+    vector<int> steps;
+    steps.reserve(pairs.size());
+    for (auto& p : pairs) {
+        if (!static_passable(p.first / N, p.first % N) || !static_passable(p.second / N, p.second % N)) {
+            steps.push_back(-2);  // 被翻转成墙的端点不参与比较
+            continue;
+        }
+        steps.push_back(hpa_plan(p.first / N, p.first % N, p.second / N, p.second % N));
+    }
+    return steps;
+}
+
+// 先局部刷新，再全量重建，比较两次的第一步
+bool check_against_rebuild(int cr, int cc, const vector<pair<int, int>>& pairs, const char* what) {
+    hpa_refresh_cluster(cr, cc);
+    vector<int> refreshed = plan_steps(pairs);
+    init_hpa();
+    vector<int> rebuilt = plan_steps(pairs);
+    for (size_t i = 0; i < pairs.size(); i++) {
+        if (refreshed[i] == rebuilt[i]) continue;
+        int s = pairs[i].first, t = pairs[i].second;
+        cerr << what << " 簇(" << cr << "," << cc << ") 不一致: (" << s / N << "," << s % N << ") -> ("
+             << t / N << "," << t % N << ") 局部刷新=" << refreshed[i] << " 全量重建=" << rebuilt[i] << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int trials = 20, pair_count = 400;
+    vector<char*> solver_argv(1, argv[0]);
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--trials" && i + 1 < argc) {
+            trials = atoi(argv[++i]);
+        } else if (arg == "--pairs" && i + 1 < argc) {
+            pair_count = atoi(argv[++i]);
+        } else {
+            solver_argv.push_back(argv[i]);
+        }
+    }
+    parse_args((int)solver_argv.size(), solver_argv.data());
+    planner_mode = PLANNER_HPA;
+    frame_report = false;
+    solver_init();
+
+    vector<int> open_cells;
+    for (int x = 0; x < MAP_ROWS; x++)
+        for (int y = 0; y < N; y++)
+            if (static_passable(x, y)) open_cells.push_back(x * N + y);
+    if (open_cells.empty()) {
+        cerr << "地图没有可走格子" << endl;
+        return 1;
+    }
+
+    mt19937 rng(12345);
+    for (int trial = 0; trial < trials; trial++) {
+        // 在一个簇内随机挑一个格子翻转；墙变空地或空地变墙都覆盖到
+        int k = rng() % HPA_KN;
+        int cr = k / HPA_KC, cc = k % HPA_KC;
+        int x0 = cr * HPA_C, y0 = cc * HPA_C;
+        int x = x0 + rng() % (min(x0 + HPA_C, MAP_ROWS) - x0);
+        int y = y0 + rng() % (min(y0 + HPA_C, N) - y0);
+
+        // 一半起点放在被修改的簇及其周围，使细化搜索经过变化的区域
+        vector<pair<int, int>> pairs;
+        for (int i = 0; i < pair_count; i++) {
+            int s = open_cells[rng() % open_cells.size()];
+            if (i % 2 == 0) {
+                int sx = max(0, min(MAP_ROWS - 1, x - HPA_C + (int)(rng() % (2 * HPA_C))));
+                int sy = max(0, min(N - 1, y - HPA_C + (int)(rng() % (2 * HPA_C))));
+                if (static_passable(sx, sy)) s = sx * N + sy;
+            }
+            pairs.push_back({s, open_cells[rng() % open_cells.size()]});
+        }
+
+        toggle_wall(x, y);
+        if (!check_against_rebuild(cr, cc, pairs, "翻转后")) return 1;
+        toggle_wall(x, y);
+        if (!check_against_rebuild(cr, cc, pairs, "恢复后")) return 1;
+    }
+    cout << "OK" << endl;
+    return 0;
+}
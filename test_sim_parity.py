@@ -0,0 +1,65 @@
+import subprocess
+import sys
+import re
+
+# 一致性测试：同一组固定种子下，judge.py 评测 main 的得分应与 sim（进程内模拟器）完全相同
+# 用法：python test_sim_parity.py [传给两边的额外参数，如 --map maps/big.txt]
+# 决策程序的每帧时间预算按实际耗时截断，会让结果依赖机器快慢，因此两边都以 --budget 0 运行
+
+def compile_cpp(source_file, exe_file):
+    cmd = ["g++", source_file, "-o", exe_file, "-O2", "-std=c++11"]
+    try:
+        subprocess.check_call(cmd)
+        return exe_file
+    except subprocess.CalledProcessError:
+        print(f"Compilation failed for {source_file}")
+        return None
+
+def run_judge(exe_file, seed, extra):
+    cmd = [sys.executable, "judge.py", exe_file, str(seed)] + extra
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    match = re.search(r"Final Score: (\d+)", result.stdout)
+    return int(match.group(1)) if match else None
+
+def run_sim(sim_file, seeds, extra):
+    """在同一进程里依次跑 seeds，返回按顺序的 [(种子, 得分, 泊位数)]"""
+    cmd = [sim_file] + extra + [str(s) for s in seeds]
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    berths = re.findall(r"Seed (-?\d+): Berths: (\d+)", result.stdout)
+    scores = re.findall(r"Seed (-?\d+): Final Score: (\d+)", result.stdout)
+    return [(int(s), int(v), int(b)) for (s, v), (_, b) in zip(scores, berths)]
+
+if __name__ == "__main__":
+    extra = sys.argv[1:] + ["--budget", "0"]
+    seeds = list(range(1233, 1233 + 10))  # 与 test_versions.py 相同的固定种子区间
+
+    main_exe = compile_cpp("main.cpp", "main_parity.exe")
+    sim_exe = compile_cpp("sim_main.cpp", "sim_parity.exe")
+    if not main_exe or not sim_exe:
+        sys.exit(1)
+
+    # 末尾再跑一次第一个种子：同一进程内重新 solver_init() 后泊位数与得分都应与第一局相同
+    sim_runs = run_sim("./" + sim_exe, seeds + [seeds[0]], extra)
+    sim_scores = {seed: score for seed, score, _ in sim_runs[:len(seeds)]}
+    mismatches = 0
+    print(f"{'Seed':<8} | {'judge.py':<10} | {'sim':<10}")
+    print("-" * 34)
+    for seed in seeds:
+        judge_score = run_judge("./" + main_exe, seed, extra)
+        sim_score = sim_scores.get(seed)
+        flag = "" if judge_score == sim_score else "  <-- MISMATCH"
+        if flag: mismatches += 1
+        print(f"{seed:<8} | {str(judge_score):<10} | {str(sim_score):<10}{flag}")
+    print("-" * 34)
+    if len(sim_runs) != len(seeds) + 1:
+        print("Simulator did not finish every game.")
+        mismatches += 1
+    else:
+        first, again = sim_runs[0], sim_runs[-1]
+        if len(set(b for _, _, b in sim_runs)) != 1 or again[1] != first[1]:
+            print(f"Re-initialisation changed the game: first run {first}, repeated run {again}")
+            mismatches += 1
+        else:
+            print(f"Repeated seed {first[0]} after re-initialisation: score {again[1]}, berths {again[2]} (unchanged)")
+    print("All scores match." if mismatches == 0 else f"{mismatches} mismatches.")
+    sys.exit(1 if mismatches else 0)